@@ -0,0 +1,520 @@
+/************************************************************************/
+/*																		*/
+/*	Control.c	--  Wheel Speed Control Task                            */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the control tick: the Timer 4  */
+/*  interrupt, the per-wheel PID instances, setpoints and profiles, the */
+/*  wheel cross-coupling, the telemetry channels of the loop and the    */
+/*  tick timing statistics.                                             */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <plib.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Encoder.h"
+#include "Odom.h"
+#include "Pid.h"
+#include "Pwm.h"
+#include "Ffwd.h"
+#include "Tune.h"
+#include "Fric.h"
+#include "Profile.h"
+#include "Move.h"
+#include "Telem.h"
+#include "Control.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	bnT4If			16	// Bit in IFS0/IEC0 for Timer 4
+
+#define	SpdAbs(spd)		( ( (spd) < 0 ) ? -(spd) : (spd) )
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+Q16			spdSetLeft = Q16FromFloat(0.6);
+Q16			spdSetRight = Q16FromFloat(0.75);
+
+struct pid	pidLeft;
+struct pid	pidRight;
+
+struct prof	profLeft;
+struct prof	profRight;
+
+struct ctrlstat	ctrlstat;
+struct ctrlsync	ctrlsync;
+
+Q16			dtcCtrlLeft;
+Q16			dtcCtrlRight;
+
+BYTE		fbCtrlTrig = fbCtrlTrigSet | fbCtrlTrigErr | fbCtrlTrigBtn;
+Q16			spdCtrlTrigErr = spdTrigErrWheel;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+/*	Setpoints at the previous tick, for the scope trigger.
+*/
+static	Q16		spdTrigLeft;
+static	Q16		spdTrigRight;
+
+/*	Wheel gain schedule. Near the stiction end the motor needs more
+**	duty per ft/s and the loop more gain to break away and hold speed;
+**	toward full duty the gains come down so the output does not wind
+**	into the limit. Autotune scales the whole table.
+*/
+static const struct pidgain	rggainWheel[] = {
+	{ Q16FromFloat(0.25),	Q16FromFloat(3000.0),	Q16FromFloat(14000.0),	Q16FromFloat(0.575) },
+	{ Q16FromFloat(0.75),	kpWheel,				kiWheel,				kdWheel },
+	{ Q16FromFloat(1.5),	Q16FromFloat(2000.0),	Q16FromFloat(8000.0),	Q16FromFloat(0.46) },
+	{ Q16FromFloat(2.2),	Q16FromFloat(1500.0),	Q16FromFloat(5000.0),	Q16FromFloat(0.35) },
+};
+
+static const struct pidsched	pidschedWheel = {
+	sizeof(rggainWheel) / sizeof(rggainWheel[0]), rggainWheel
+};
+
+/*	Telemetry recorded every tick: the right wheel loop in full and
+**	the left speed.
+*/
+static const struct telemch	rgchCtrl[] = {
+	{ &encRight.spdEst,	bnTelemSpd },
+	{ &pidRight.p,		bnTelemDtc },
+	{ &pidRight.i,		bnTelemDtc },
+	{ &pidRight.d,		bnTelemDtc },
+	{ &dtcCtrlRight,	bnTelemDtc },
+	{ &encLeft.spdEst,	bnTelemSpd },
+};
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	void	CtrlSyncUpdate(BOOL fOn, Q16 spdLeft, Q16 spdRight);
+static	void	CtrlStatRecord(WORD cycLat, WORD cycRun, BOOL fOverrun);
+static	WORD	ICtrlStatBin(WORD cyc);
+static	void	CtrlTrigCheck(Q16 spdCmdLeft, Q16 spdCmdRight);
+
+/* ------------------------------------------------------------ */
+/*				Interrupt Service Routines	            	    */
+/* ------------------------------------------------------------ */
+/***	Timer4Handler
+**
+**	Parameters:
+**		none
+**
+**	Return Value:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Control tick. Runs the speed estimator on every edge captured
+**		up to one snapshot of both wheels, advances the odometry, and
+**		updates both wheel PIDs and the motor duty cycles. While a
+**		feedforward sweep runs it drives the motors instead, and the
+**		PIDs are held reset; while a wheel tunes, its relay replaces
+**		its PID. Otherwise the setpoints are shaped by the profiles
+**		and get the cross-coupling correction before the PIDs see
+**		them, and each PID runs under the static friction compensation
+**		of its wheel (Fric.h). The outputs are signed, so a wheel is
+**		controlled through zero and in reverse; PwmSet takes care of
+**		switching the motor direction. The tick ends with a telemetry
+**		record (Telem.h), stamped with the snapshot time; the scope
+**		trigger conditions are checked just before it. Timer 4
+**		restarts from zero at the period match, so its count on entry
+**		is the start latency.
+*/
+
+void __ISR(_TIMER_4_VECTOR, ipl4) Timer4Handler(void)
+{
+	WORD			tckStart = _CP0_GET_COUNT();
+	WORD			tckLat = TMR4;
+	WORD			tusNow;
+	Q16				dtcLeft;
+	Q16				dtcRight;
+	Q16				spdRefLeft;
+	Q16				spdRefRight;
+	Q16				spdCmdLeft;
+	Q16				spdCmdRight;
+	BOOL			fSweep;
+
+	IFS0CLR = ( 1 << bnT4If );
+
+	tusNow = EncSnapshot();
+	EncUpdate(&encLeft, tusNow);
+	EncUpdate(&encRight, tusNow);
+	OdomUpdate(encLeft.cTick, encRight.cTick);
+
+	fSweep = FFfwdSweepTick(encLeft.spd, encRight.spd, &dtcLeft);
+	if ( fSweep ) {
+		ProfReset(&profLeft, 0);
+		ProfReset(&profRight, 0);
+	}
+	MoveTick();
+	spdRefLeft = ProfTick(&profLeft, spdSetLeft);
+	spdRefRight = ProfTick(&profRight, spdSetRight);
+
+	CtrlSyncUpdate(OPT_WHEELSYNC && !fSweep && !FTuneRunning(), spdRefLeft, spdRefRight);
+
+	// The correction slows the wheel that is ahead in its direction of travel.
+	spdCmdLeft = spdRefLeft - ( ( spdRefRight < 0 ) ? -ctrlsync.spdAdj : ctrlsync.spdAdj );
+	spdCmdRight = spdRefRight + ( ( spdRefLeft < 0 ) ? -ctrlsync.spdAdj : ctrlsync.spdAdj );
+
+	if ( fSweep ) {
+		PidReset(&pidRight);
+		PidReset(&pidLeft);
+		dtcRight = dtcLeft;
+	}
+	else {
+		PidSchedule(&pidRight, SpdAbs(spdSetRight));
+		PidSchedule(&pidLeft, SpdAbs(spdSetLeft));
+
+		// Output is signed OC duty in Q16, at most dtcPwmMax either way
+		if ( !FTuneTick(&tuneRight, &pidRight, spdCmdRight, encRight.spdEst, &dtcRight) ) {
+			dtcRight = FricUpdate(&fricRight, &pidRight, spdCmdRight, encRight.spdEst,
+								  FfwdDuty(&ffwdRight, spdCmdRight));
+		}
+		if ( !FTuneTick(&tuneLeft, &pidLeft, spdCmdLeft, encLeft.spdEst, &dtcLeft) ) {
+			dtcLeft = FricUpdate(&fricLeft, &pidLeft, spdCmdLeft, encLeft.spdEst,
+								 FfwdDuty(&ffwdLeft, spdCmdLeft));
+		}
+	}
+
+	PwmSet(&pwmLeft, IntFromQ16(dtcLeft));
+	PwmSet(&pwmRight, IntFromQ16(dtcRight));
+
+	dtcCtrlLeft = dtcLeft;
+	dtcCtrlRight = dtcRight;
+	if ( OPT_TELEMSCOPE ) {
+		CtrlTrigCheck(spdCmdLeft, spdCmdRight);
+	}
+	TelemRecord(tusNow);
+
+	// The core timer counts at half the system clock.
+	CtrlStatRecord(tckLat * cycCtrlTmr, 2 * ( _CP0_GET_COUNT() - tckStart ),
+				   ( IFS0 & ( 1 << bnT4If ) ) != 0);
+}
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	CtrlInit
+**
+**	Synopsis:
+**		CtrlInit()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Sets up both wheel PIDs and the loop telemetry, and starts
+**		Timer 4 at frqCtrlTick.
+**		Call after EncInit and PwmInit, with interrupts not yet
+**		enabled.
+*/
+
+void CtrlInit(void)
+{
+	// Wheel speed controllers: ft/s in, OC duty out
+	PidInit(&pidRight, tusCtrlTick, -Q16FromInt(dtcPwmMax), Q16FromInt(dtcPwmMax), OPT_PIDAW);
+	PidSetSchedule(&pidRight, &pidschedWheel, SpdAbs(spdSetRight));
+	PidInit(&pidLeft, tusCtrlTick, -Q16FromInt(dtcPwmMax), Q16FromInt(dtcPwmMax), OPT_PIDAW);
+	PidSetSchedule(&pidLeft, &pidschedWheel, SpdAbs(spdSetLeft));
+
+	// Static friction; the PID floors are set every tick from these
+	FricInit(&fricRight, tusCtrlTick);
+	FricInit(&fricLeft, tusCtrlTick);
+
+	// Setpoint shaping
+	ProfInit(&profRight, accProfWheel, jerkProfWheel, tusCtrlTick);
+	ProfInit(&profLeft, accProfWheel, jerkProfWheel, tusCtrlTick);
+
+	// Telemetry of the loop, as deep as the pool allows or as a scope
+	// capture, and on the UART if it is streamed (UartInit has been
+	// called)
+	FTelemConfig(rgchCtrl, sizeof(rgchCtrl) / sizeof(rgchCtrl[0]), 0, modeTelemRing);
+#if OPT_TELEMSCOPE
+	FTelemScope(crecCtrlPre, crecCtrlPost);
+	spdTrigLeft		= spdSetLeft;
+	spdTrigRight	= spdSetRight;
+#else
+	TelemStart();
+#endif
+	TelemStream(OPT_TELEMUART);
+
+	T4CON	= 0;
+	TMR4	= 0;
+	PR4		= prCtrl;
+
+	CtrlStatReset();
+
+	ctrlsync.cTickLeft	= encLeft.cTick;
+	ctrlsync.cTickRight	= encRight.cTick;
+	ctrlsync.ftErr		= 0;
+	ctrlsync.spdAdj		= 0;
+
+	IPC4SET	= ( iplCtrl << 2 ) | ipsCtrl;
+	IFS0CLR	= ( 1 << bnT4If );
+	IEC0SET	= ( 1 << bnT4If );
+
+	// Bit 15 is the enable; TCKPS is bits 6:4
+	T4CON	= ( 1 << 15 ) | ( tckpsCtrl << 4 );
+}
+
+/* ------------------------------------------------------------ */
+/***	CtrlStatReset
+**
+**	Synopsis:
+**		CtrlStatReset()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Clears the tick timing statistics. May be called from any
+**		priority.
+*/
+
+void CtrlStatReset(void)
+{
+	unsigned int	st;
+	WORD			ibin;
+
+	st = INTDisableInterrupts();
+	ctrlstat.cTick		= 0;
+	ctrlstat.cOverrun	= 0;
+	ctrlstat.cycLatMin	= 0xFFFFFFFF;
+	ctrlstat.cycLatMax	= 0;
+	ctrlstat.cycRunMin	= 0xFFFFFFFF;
+	ctrlstat.cycRunMax	= 0;
+	for ( ibin = 0; ibin < cCtrlStatBin; ibin++ ) {
+		ctrlstat.rgcLat[ibin] = 0;
+		ctrlstat.rgcRun[ibin] = 0;
+	}
+	INTRestoreInterrupts(st);
+}
+
+/* ------------------------------------------------------------ */
+/***	CtrlSyncUpdate
+**
+**	Synopsis:
+**		CtrlSyncUpdate(fOn, spdLeft, spdRight)
+**
+**	Parameters:
+**		fOn      - cross-coupling is enabled this tick
+**		spdLeft  - left speed reference sL, ft/s
+**		spdRight - right speed reference sR, ft/s
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Adds this tick's wheel travel to the synchronization error
+**		and recomputes the correction. The error grows by
+**
+**			( dL sR - dR sL ) / ( |sL| + |sR| )
+**
+**		ticks, which is zero whenever the wheels move in the ratio
+**		of the references, including opposite directions for a turn
+**		in place. Applying the correction with the signs used in
+**		Timer4Handler makes the error decay at kSyncWheel. The error
+**		is cleared while disabled or while both references are zero.
+*/
+
+static void CtrlSyncUpdate(BOOL fOn, Q16 spdLeft, Q16 spdRight)
+{
+	int32_t	dtickL = encLeft.cTick - ctrlsync.cTickLeft;
+	int32_t	dtickR = encRight.cTick - ctrlsync.cTickRight;
+	int32_t	spdDen;
+	int64_t	ftErr;
+	int64_t	spdAdj;
+
+	ctrlsync.cTickLeft	= encLeft.cTick;
+	ctrlsync.cTickRight	= encRight.cTick;
+
+	spdDen = SpdAbs(spdLeft) + SpdAbs(spdRight);
+
+	if ( !fOn || ( spdDen == 0 ) ) {
+		ctrlsync.ftErr	= 0;
+		ctrlsync.spdAdj	= 0;
+		return;
+	}
+
+	// Ticks times Q24 feet per tick is Q24 feet; >> 8 makes it Q16.
+	ftErr = ctrlsync.ftErr +
+			( ( ( (int64_t)dtickL * spdRight - (int64_t)dtickR * spdLeft ) *
+				ftOdomTickQ24 / spdDen ) >> 8 );
+	if ( ftErr > ftSyncErrMax ) {
+		ftErr = ftSyncErrMax;
+	}
+	if ( ftErr < -ftSyncErrMax ) {
+		ftErr = -ftSyncErrMax;
+	}
+	ctrlsync.ftErr = (Q16)ftErr;
+
+	spdAdj = ( (int64_t)kSyncWheel * ctrlsync.ftErr ) >> bnQ16Frac;
+	if ( spdAdj > spdSyncMax ) {
+		spdAdj = spdSyncMax;
+	}
+	if ( spdAdj < -spdSyncMax ) {
+		spdAdj = -spdSyncMax;
+	}
+	ctrlsync.spdAdj = (Q16)spdAdj;
+}
+
+/* ------------------------------------------------------------ */
+/***	CtrlStatRecord
+**
+**	Synopsis:
+**		CtrlStatRecord(cycLat, cycRun, fOverrun)
+**
+**	Parameters:
+**		cycLat   - start latency of this tick, cycles
+**		cycRun   - run time of this tick, cycles
+**		fOverrun - the next tick was already due at the end
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Folds one tick into ctrlstat.
+*/
+
+static void CtrlStatRecord(WORD cycLat, WORD cycRun, BOOL fOverrun)
+{
+	ctrlstat.cTick++;
+	if ( fOverrun ) {
+		ctrlstat.cOverrun++;
+	}
+
+	if ( cycLat < ctrlstat.cycLatMin ) {
+		ctrlstat.cycLatMin = cycLat;
+	}
+	if ( cycLat > ctrlstat.cycLatMax ) {
+		ctrlstat.cycLatMax = cycLat;
+	}
+	if ( cycRun < ctrlstat.cycRunMin ) {
+		ctrlstat.cycRunMin = cycRun;
+	}
+	if ( cycRun > ctrlstat.cycRunMax ) {
+		ctrlstat.cycRunMax = cycRun;
+	}
+
+	ctrlstat.rgcLat[ICtrlStatBin(cycLat)]++;
+	ctrlstat.rgcRun[ICtrlStatBin(cycRun)]++;
+}
+
+/* ------------------------------------------------------------ */
+/***	ICtrlStatBin
+**
+**	Synopsis:
+**		ibin = ICtrlStatBin(cyc)
+**
+**	Parameters:
+**		cyc - duration in cycles
+**
+**	Return Values:
+**		histogram bin for cyc
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Power of two microsecond bins; one CLZ instruction. The
+**		divide is by a constant, so it compiles to a multiply.
+*/
+
+static WORD ICtrlStatBin(WORD cyc)
+{
+	WORD	us = cyc / cycCtrlStatUs;
+	WORD	ibin;
+
+	if ( us == 0 ) {
+		return 0;
+	}
+	ibin = 32 - __builtin_clz(us);
+	return ( ibin < cCtrlStatBin ) ? ibin : cCtrlStatBin - 1;
+}
+
+/* ------------------------------------------------------------ */
+/***	CtrlTrigCheck
+**
+**	Synopsis:
+**		CtrlTrigCheck(spdCmdLeft, spdCmdRight)
+**
+**	Parameters:
+**		spdCmdLeft  - speeds the wheel PIDs were given this tick
+**		spdCmdRight
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Triggers the scope on the conditions fbCtrlTrig enables: a
+**		change in either setpoint since the last tick, or either
+**		wheel off its commanded speed by more than spdCtrlTrigErr.
+*/
+
+static void CtrlTrigCheck(Q16 spdCmdLeft, Q16 spdCmdRight)
+{
+	BYTE	fbSrc = 0;
+
+	if ( ( spdSetLeft != spdTrigLeft ) || ( spdSetRight != spdTrigRight ) ) {
+		fbSrc |= fbCtrlTrigSet;
+	}
+	spdTrigLeft		= spdSetLeft;
+	spdTrigRight	= spdSetRight;
+
+	if ( ( SpdAbs(spdCmdLeft - encLeft.spdEst) > spdCtrlTrigErr ) ||
+		 ( SpdAbs(spdCmdRight - encRight.spdEst) > spdCtrlTrigErr ) ) {
+		fbSrc |= fbCtrlTrigErr;
+	}
+
+	fbSrc &= fbCtrlTrig;
+	if ( fbSrc != 0 ) {
+		TelemTrigger(fbSrc);
+	}
+}
+
+/************************************************************************/
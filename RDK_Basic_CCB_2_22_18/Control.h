@@ -0,0 +1,195 @@
+/************************************************************************/
+/*																		*/
+/*	Control.h	--  Wheel Speed Control Task                            */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for the closed loop control       */
+/*  tick. Timer 4 runs it at IPL4: below the encoder capture ISRs       */
+/*  (IPL6) and the timebase overflow (IPL5), so it never delays a       */
+/*  capture timestamp. Button and switch debouncing stays on Timer 5,   */
+/*  at IPL2.                                                            */
+/*																		*/
+/*  Each tick takes a snapshot of both wheels at one instant, updates   */
+/*  the speed estimates and odometry from it, moves each wheel's speed  */
+/*  reference toward its setpoint with an S-curve profile (Profile.h),  */
+/*  and runs one PID per wheel, with the feedforward table of that      */
+/*  wheel (Ffwd.h) added to its output and its limits set by the static */
+/*  friction compensation (Fric.h). The outputs are signed duty cycles  */
+/*  over the whole range, so a wheel is controlled through zero and in  */
+/*  reverse; Pwm.c switches the motor direction safely. Each tick ends  */
+/*  with a telemetry record of the right wheel loop and the left speed  */
+/*  (Telem.h), which replaces the float hist0..hist5 arrays. With       */
+/*  OPT_TELEMSCOPE the recorder runs as a scope: a setpoint change, a   */
+/*  wheel speed error over spdCtrlTrigErr or BTN2 triggers it, as       */
+/*  fbCtrlTrig allows, and it holds crecCtrlPre records from before the */
+/*  trigger and crecCtrlPost from after.                                */
+/*																		*/
+/*  With OPT_WHEELSYNC the two loops are cross-coupled. The tick        */
+/*  counts are integrated into a synchronization error: how far, in     */
+/*  feet, the wheels have drifted from the commanded speed ratio. A     */
+/*  speed correction proportional to it slows the wheel that is ahead   */
+/*  and speeds up the one behind, so the error decays at kSyncWheel     */
+/*  per second instead of accumulating as heading drift.                */
+/*																		*/
+/*  The tick rate is frqCtrlTick in config.h; the Timer 4 prescale and  */
+/*  period are worked out from it at compile time. Every tick records   */
+/*  its start latency and run time in ctrlstat so the rate can be       */
+/*  raised as far as the CPU allows.                                    */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_CONTROL_INC)
+#define _CONTROL_INC
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Pid.h"
+#include "Profile.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Timer 4 prescale for frqCtrlTick: the smallest one that lets the
+**	period fit in 16 bits. tckpsCtrl is its TCKPS encoding.
+*/
+#define	FCtrlPsFits(cps)	( ( frqPbClk / ( (cps) * frqCtrlTick ) ) <= 65536 )
+#define	cpsCtrl			( FCtrlPsFits(1) ? 1 : FCtrlPsFits(2) ? 2 :			\
+						  FCtrlPsFits(4) ? 4 : FCtrlPsFits(8) ? 8 :			\
+						  FCtrlPsFits(16) ? 16 : FCtrlPsFits(32) ? 32 :		\
+						  FCtrlPsFits(64) ? 64 : 256 )
+#define	tckpsCtrl		( cpsCtrl == 1 ? 0 : cpsCtrl == 2 ? 1 :				\
+						  cpsCtrl == 4 ? 2 : cpsCtrl == 8 ? 3 :				\
+						  cpsCtrl == 16 ? 4 : cpsCtrl == 32 ? 5 :			\
+						  cpsCtrl == 64 ? 6 : 7 )
+
+#if !FCtrlPsFits(256)
+#error "frqCtrlTick is too low for Timer 4"
+#endif
+
+/*	Control tick period, the actual one after rounding, in Timer 4
+**	counts and in microseconds, and core clock cycles per Timer 4 count.
+*/
+#define	prCtrl			( ( frqPbClk / ( cpsCtrl * frqCtrlTick ) ) - 1 )
+#define	tusCtrlTick		((WORD)( ( (DWORD)cpsCtrl * ( prCtrl + 1 ) * 1000000 ) / frqPbClk ))
+#define	cycCtrlTmr		( cpsCtrl * ( frqSysClk / frqPbClk ) )
+
+/*	Control tick priority. iplCtrl must match the ipl4 in Timer4Handler
+**	and stay below iplEnc.
+*/
+#define	iplCtrl			4
+#define	ipsCtrl			3
+
+/*	Wheel speed PID settings. The gains are the hand tuned Kp = 2500,
+**	Ki = Kp/10 and Kd = Kp/100 per 23 ms tick, in per-second units so
+**	they carry over to other tick rates. They are the 0.75 ft/s entry
+**	of the gain schedule in Control.c, which is keyed by the magnitude
+**	of the wheel setpoint.
+*/
+#define	kpWheel			Q16FromFloat(2500.0)	// duty per ft/s
+#define	kiWheel			Q16FromFloat(10870.0)	// duty per ft/s per s
+#define	kdWheel			Q16FromFloat(0.575)		// duty per ft/s^2
+
+/*	Setpoint profile limits. Set jerkProfWheel to 0 for a trapezoid.
+*/
+#define	accProfWheel	Q16FromFloat(2.0)	// ft/s^2
+#define	jerkProfWheel	Q16FromFloat(10.0)	// ft/s^3
+
+/*	Cross-coupling gain and limits. The correction is applied to the
+**	setpoints, so the wheel PIDs and feedforward see it as a speed.
+*/
+#define	kSyncWheel		Q16FromFloat(2.0)	// ft/s per ft of error
+#define	spdSyncMax		Q16FromFloat(0.2)	// correction limit
+#define	ftSyncErrMax	Q16FromFloat(0.5)	// error limit
+
+/*	Scope capture depths, 1.5 s before the trigger and 4.5 s from it
+**	at 43 Hz, the trigger sources, for fbCtrlTrig and the fbTrigHit of
+**	a capture, and the default speed error threshold.
+*/
+#define	crecCtrlPre		64
+#define	crecCtrlPost	192
+
+#define	fbCtrlTrigSet	0x01	// a wheel setpoint changed
+#define	fbCtrlTrigErr	0x02	// a wheel speed error over spdCtrlTrigErr
+#define	fbCtrlTrigBtn	0x04	// BTN2 pressed, from main.c
+
+#define	spdTrigErrWheel	Q16FromFloat(0.3)	// ft/s
+
+/*	Tick timing statistics, in core clock cycles. Start latency is the
+**	time from the Timer 4 period match to the first instruction of
+**	Timer4Handler (from the Timer 4 count); run time is measured with
+**	the core timer. Histogram bin 0 is under 1 us (cycCtrlStatUs
+**	cycles) and bin k counts [2^(k-1), 2^k) us; the last bin also takes
+**	everything longer. An overrun is a tick that ended after the next
+**	one was due.
+*/
+#define	cCtrlStatBin	16
+#define	cycCtrlStatUs	( frqSysClk / 1000000 )	// core cycles per microsecond
+
+#if ( frqSysClk % 1000000 ) != 0
+#error "frqSysClk must be a whole number of MHz for the tick statistics"
+#endif
+
+struct ctrlstat {
+	WORD	cTick;
+	WORD	cOverrun;
+	WORD	cycLatMin;
+	WORD	cycLatMax;
+	WORD	cycRunMin;
+	WORD	cycRunMax;
+	WORD	rgcLat[cCtrlStatBin];
+	WORD	rgcRun[cCtrlStatBin];
+};
+
+/*	Cross-coupling state. ftErr is positive when the left wheel is
+**	ahead of the commanded ratio.
+*/
+struct ctrlsync {
+	int32_t	cTickLeft;		// wheel counts at the previous tick
+	int32_t	cTickRight;
+	Q16		ftErr;			// synchronization error, feet
+	Q16		spdAdj;			// correction, ft/s
+};
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	Q16			spdSetLeft;		// ft/s
+extern	Q16			spdSetRight;
+
+extern	struct pid	pidLeft;		// OC2
+extern	struct pid	pidRight;		// OC3
+
+extern	struct prof	profLeft;		// speed references
+extern	struct prof	profRight;
+
+extern	struct ctrlstat	ctrlstat;
+extern	struct ctrlsync	ctrlsync;
+
+extern	Q16			dtcCtrlLeft;	// signed duty of the last tick
+extern	Q16			dtcCtrlRight;
+
+extern	BYTE		fbCtrlTrig;		// scope trigger sources enabled
+extern	Q16			spdCtrlTrigErr;
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+void	CtrlInit(void);
+void	CtrlStatReset(void);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
@@ -0,0 +1,896 @@
+/************************************************************************/
+/*																		*/
+/*	Encoder.c	--  Wheel Encoder Speed Estimation                      */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for wheel speed estimation from    */
+/*  input capture edge intervals.                                       */
+/*																		*/
+/*  Edge timestamps are queued by the capture ISRs (see EncPush) and    */
+/*  processed here at the control rate with the M/T method and the      */
+/*  speed observer.                                                     */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <plib.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "Encoder.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	cEncBench		256		// samples per benchmark pass
+
+/*	The per-edge filter the capture ISRs used to run, kept for the
+**	benchmark: avg += alpha * (spd - avg), alpha = 13/128 (~0.1).
+*/
+#define	wEncEmaNum		13
+#define	bnEncEma		7
+#define	EncEmaQ16(spdAvg, spd)	\
+	( (spdAvg) + ( ( ( (spd) - (spdAvg) ) * wEncEmaNum ) >> bnEncEma ) )
+
+/*	Observer gain table: steady-state gains for update intervals of
+**	1, 2, ... cEncObsGain half control periods. The Riccati recursion
+**	for each stops once the gains change by less than dkEncObsDone of
+**	themselves, or after cEncObsIter steps.
+*/
+#define	cEncObsGain		12
+#define	tusEncObsStep	( 1000000 / ( 2 * frqCtrlTick ) )
+#define	cEncObsIter		100
+#define	dkEncObsDone	1.0e-4
+
+/*	Travel in Q16 edges at spd ft/s for tus microseconds, and the
+**	change in speed at acc ft/s^2.
+*/
+#define	EncEdgQ16(spd, tus)		((int32_t)( ( (int64_t)(spd) * (int32_t)(tus) ) / cusEncSpd ))
+#define	EncDspdQ16(acc, tus)	((Q16)( ( (int64_t)(acc) * (int32_t)(tus) ) / 1000000 ))
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+struct enc	encLeft;
+struct enc	encRight;
+
+#if OPT_ENCBENCH
+WORD	cycEncFloat = 0;
+WORD	cycEncFixed = 0;
+#endif
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+/*	Capture prescale levels: ICM mode, edges per capture, and the
+**	|speed| above which to go up a level and below which to come down.
+*/
+static const struct {
+	BYTE	icm;
+	BYTE	cEdge;
+	Q16		spdUp;
+	Q16		spdDn;
+} rgpreEnc[cEncPre] = {
+	{ icmEvery1,   1, spdEncPre4Up,  0             },
+	{ icmEvery4,   4, spdEncPre16Up, spdEncPre4Dn  },
+	{ icmEvery16, 16, 0,             spdEncPre16Dn },
+};
+
+/*	Observer gains per Q16 edge of position error: position (edges),
+**	speed (ft/s) and acceleration (ft/s^2).
+*/
+struct encgain {
+	Q16		kPos;
+	Q16		kSpd;
+	Q16		kAcc;
+};
+
+static	struct encgain	rggainEnc[cEncObsGain];
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	void	EncObsInit(void);
+static	void	EncObsGain(float t, struct encgain * pgain);
+static	void	EncObsUpdate(struct enc * penc, WORD tusNow, int32_t cTick,
+							 BOOL fAnchor, BOOL fMeas);
+static	void	EncObsPredict(struct enc * penc, WORD tus);
+static	void	EncObsCorrect(struct enc * penc, WORD tus);
+static	BOOL	FEncAccept(struct enc * penc, WORD tusDelta);
+#if OPT_ENCPRE
+static	void	EncAdaptPrescale(struct enc * penc);
+#endif
+#if OPT_ENCFILT == 3
+static	WORD	TusMedian3(WORD tus0, WORD tus1, WORD tus2);
+#endif
+
+
+/* ------------------------------------------------------------ */
+/*				Interrupt Service Routines	            	    */
+/* ------------------------------------------------------------ */
+
+/*	One line per wheel. IC1, IC4 and IC5 can be added the same way.
+*/
+EncChannel(2, prtMtrLeftSb, bnMtrLeftSb, encLeft)
+EncChannel(3, prtMtrRightSb, bnMtrRightSb, encRight)
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	EncInit
+**
+**	Synopsis:
+**		EncInit()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Configures the capture channel of each wheel and computes the
+**		observer gains. TbInit must have been called first.
+*/
+
+void EncInit(void)
+{
+	EncObsInit();
+
+	encLeft.stSbFwd = stMtrLeftSbFwd;
+	encRight.stSbFwd = stMtrRightSbFwd;
+
+	EncChannelInit(2, trisMtrLeftSbSet, bnMtrLeftSb, encLeft);
+	EncChannelInit(3, trisMtrRightSbSet, bnMtrRightSb, encRight);
+}
+
+/* ------------------------------------------------------------ */
+/***	EncSnapshot
+**
+**	Synopsis:
+**		tusNow = EncSnapshot()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		current time, low 32 bits of TbNowUs()
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Marks the end of the control window for both wheels at the
+**		same instant. The ring heads and the time are read together
+**		with interrupts off, so the EncUpdate calls that follow see
+**		the same set of edges on each wheel and a window end that is
+**		no earlier than any of them.
+*/
+
+WORD EncSnapshot(void)
+{
+	unsigned int	st;
+	WORD			tusNow;
+
+	st = INTDisableInterrupts();
+	tusNow = (WORD)TbNowUs();
+	encLeft.iHeadSnap = encLeft.ring.iHead;
+	encRight.iHeadSnap = encRight.ring.iHead;
+	INTRestoreInterrupts(st);
+
+	return tusNow;
+}
+
+/* ------------------------------------------------------------ */
+/***	EncUpdate
+**
+**	Synopsis:
+**		EncUpdate(penc, tusNow)
+**
+**	Parameters:
+**		penc   - estimator state for one wheel
+**		tusNow - end of the window, as returned by EncSnapshot
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Drains every edge timestamp queued up to the last EncSnapshot,
+**		drops the ones FEncAccept rejects, and updates the wheel speed
+**		from the rest with the M/T method: the net signed edges in
+**		this window over the time from the last edge of the previous
+**		window to the last edge of this one. Both ends are
+**		capture timestamps, so the result has no +/-1 edge quantization
+**		at high speed. Each edge counts +1 or -1 depending on whether
+**		its SB level matches stSbFwd.
+**
+**		A window with no edges gives no new measurement, but it does
+**		say the next interval is at least tusNow - tusPrev long. The
+**		speed magnitude is lowered to that bound so it falls toward zero
+**		when the wheel stalls instead of holding its last value.
+**
+**		The edges then go to the observer (EncObsUpdate), which gives
+**		spdEst and accEst.
+**
+**		Captures taken with a prescaled mode count as cEdgeCap edges
+**		each. After a prescale change the first capture taken in the
+**		new mode restarts the speed interval, since the interval back
+**		to the last old mode capture is not a whole number of edges,
+**		but its edges still go into cTick. So do the edges the old
+**		prescaler had counted since its last capture when it was
+**		cleared: fewer than one old capture's worth, estimated from
+**		spdEst over the time from that capture to tusResync.
+**
+**		Must be called from only one context (the control tick).
+*/
+
+void EncUpdate(struct enc * penc, WORD tusNow)
+{
+	WORD	iHead = penc->iHeadSnap;	// later edges wait
+	WORD	iTail = penc->ring.iTail;
+	WORD	tusSpan = 0;
+	WORD	tusLast = penc->tusPrev;
+	BOOL	fLast = penc->fPrev;
+	WORD	tus;
+	WORD	cEdge = 0;
+	int32_t	cTick = 0;
+	int32_t	cTickObs = 0;			// net edges since the observer's capture
+	BOOL	fAnchor = fFalse;
+	int32_t	dtick;
+	int32_t	cTickLost;
+	Q16		spdAbs;
+	Q16		spdMax;
+
+	while ( iTail != iHead ) {
+		tus = penc->ring.rgtus[iTail];
+		dtick = ( penc->ring.rgstSb[iTail] == penc->stSbFwd ) ? 1 : -1;
+		iTail = (iTail + 1) & mskEncRing;
+
+		if ( penc->fResync && ( (int32_t)(tus - penc->tusResync) >= 0 ) ) {
+			// First capture in the new prescale mode.
+			penc->fResync = fFalse;
+			if ( fLast ) {
+				spdAbs = ( penc->spdEst < 0 ) ? -penc->spdEst : penc->spdEst;
+				cTickLost = IntFromQ16(EncEdgQ16(spdAbs, penc->tusResync - tusLast) +
+									   ( 1 << ( bnQ16Frac - 1 ) ));
+				if ( cTickLost > (int32_t)penc->cEdgeCap - 1 ) {
+					cTickLost = (int32_t)penc->cEdgeCap - 1;
+				}
+				penc->cEdgeCap = rgpreEnc[penc->lvlPre].cEdge;
+				penc->cTick += dtick * ( cTickLost + (int32_t)penc->cEdgeCap );
+				penc->cAccept++;
+				tusLast = tus;
+				fAnchor = fTrue;
+				cTickObs = 0;
+				continue;
+			}
+			penc->cEdgeCap = rgpreEnc[penc->lvlPre].cEdge;
+		}
+		dtick *= (int32_t)penc->cEdgeCap;
+
+		if ( ! fLast ) {
+			// The first edge ever only starts the clock.
+			fLast = fTrue;
+			tusLast = tus;
+			fAnchor = fTrue;
+			penc->cTick += dtick;
+			penc->cAccept++;
+			continue;
+		}
+
+		if ( ! FEncAccept(penc, (tus - tusLast) / penc->cEdgeCap) ) {
+			penc->cReject++;
+			continue;
+		}
+
+		penc->cAccept++;
+		tusSpan += tus - tusLast;
+		tusLast = tus;
+		cEdge += penc->cEdgeCap;
+		cTick += dtick;
+		cTickObs += dtick;
+	}
+
+	// Hand the slots back to the ISR in one store.
+	penc->ring.iTail = iTail;
+
+	penc->fPrev = fLast;
+	penc->tusPrev = tusLast;
+
+	if ( cEdge == 0 ) {
+		if ( fLast ) {
+			// No capture means fewer than one capture's worth of edges.
+			spdMax = EncSpeedMtQ16(rgpreEnc[penc->lvlPre].cEdge, tusNow - tusLast);
+			if ( penc->spd > spdMax ) {
+				penc->spd = spdMax;
+			}
+			else if ( penc->spd < -spdMax ) {
+				penc->spd = -spdMax;
+			}
+		}
+	}
+	else {
+		penc->cTick += cTick;
+		penc->spd = EncSpeedMtQ16(cTick, tusSpan);
+	}
+
+	EncObsUpdate(penc, tusNow, cTickObs, fAnchor, ( cEdge != 0 ));
+
+#if OPT_ENCPRE
+	EncAdaptPrescale(penc);
+#endif
+}
+
+#if OPT_ENCPRE
+/* ------------------------------------------------------------ */
+/***	EncAdaptPrescale
+**
+**	Synopsis:
+**		EncAdaptPrescale(penc)
+**
+**	Parameters:
+**		penc - estimator state for one wheel
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Moves the capture prescale at most one level per call based on
+**		the observer speed. The module is turned off to change mode,
+**		which clears its FIFO and prescale counter, and back on in the
+**		new mode. tusResync, taken while the module is off, marks the
+**		switch so EncUpdate can tell old mode captures from new ones
+**		even if the capture ISR was preempted holding an old capture:
+**		no capture can happen between the off and on writes. There is
+**		no second switch until the first capture in the new mode has
+**		been seen.
+*/
+
+static void EncAdaptPrescale(struct enc * penc)
+{
+	Q16		spd = ( penc->spdEst < 0 ) ? -penc->spdEst : penc->spdEst;
+	BYTE	lvl = penc->lvlPre;
+
+	if ( penc->fResync ) {
+		return;
+	}
+
+	if ( ( lvl < cEncPre - 1 ) && ( spd > rgpreEnc[lvl].spdUp ) ) {
+		lvl++;
+	}
+	else if ( ( lvl > 0 ) && ( spd < rgpreEnc[lvl].spdDn ) ) {
+		lvl--;
+	}
+
+	if ( lvl == penc->lvlPre ) {
+		return;
+	}
+
+	*penc->picCon = 0;
+	penc->tusResync = (WORD)TbNowUs();
+	*penc->picCon = bitsIcTmr | rgpreEnc[lvl].icm;
+	*penc->picCon = ( 1 << bnIcOn ) | bitsIcTmr | rgpreEnc[lvl].icm;
+
+	penc->lvlPre = lvl;
+	penc->fResync = fTrue;
+}
+#endif
+
+/* ------------------------------------------------------------ */
+/***	EncObsInit
+**
+**	Synopsis:
+**		EncObsInit()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Fills the observer gain table. Runs once, in float.
+*/
+
+static void EncObsInit(void)
+{
+	int		igain;
+
+	for ( igain = 0; igain < cEncObsGain; igain++ ) {
+		EncObsGain(( igain + 1 ) * ( tusEncObsStep / 1000000.0 ), &rggainEnc[igain]);
+	}
+}
+
+/* ------------------------------------------------------------ */
+/***	EncObsGain
+**
+**	Synopsis:
+**		EncObsGain(t, pgain)
+**
+**	Parameters:
+**		t     - update interval, seconds
+**		pgain - receives the gains
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Computes the steady-state Kalman gain for position updates
+**		every t seconds. The model is a wheel position x (edges)
+**		driven by white jerk of spectral density q, measured with
+**		variance r:
+**
+**			F = | 1  t  t^2/2 |    Q = q | t^5/20  t^4/8  t^3/6 |
+**			    | 0  1  t     |          | t^4/8   t^3/3  t^2/2 |
+**			    | 0  0  1     |          | t^3/6   t^2/2  t     |
+**
+**		The Riccati recursion is run until the gain stops changing.
+**		The gains are the alpha, beta / t and 2 gamma / t^2 of an
+**		alpha-beta-gamma filter.
+*/
+
+static void EncObsGain(float t, struct encgain * pgain)
+{
+	float	spdEdge = cusEncSpd / 1000000.0;		// ft/s per edge/s
+	float	q = ( jerkEncNoise / spdEdge ) * ( jerkEncNoise / spdEdge );
+	float	r = edgEncNoise * edgEncNoise;
+	float	rgq[3][3];
+	float	rgf[3][3];
+	float	rgp[3][3];
+	float	rgpp[3][3];
+	float	rgk[3];
+	float	kAccPrev = 0;
+	float	s;
+	int		i;
+	int		j;
+	int		l;
+	int		iter;
+
+	rgq[0][0] = q * t * t * t * t * t / 20;
+	rgq[0][1] = q * t * t * t * t / 8;
+	rgq[0][2] = q * t * t * t / 6;
+	rgq[1][1] = q * t * t * t / 3;
+	rgq[1][2] = q * t * t / 2;
+	rgq[2][2] = q * t;
+	rgq[1][0] = rgq[0][1];
+	rgq[2][0] = rgq[0][2];
+	rgq[2][1] = rgq[1][2];
+
+	for ( i = 0; i < 3; i++ ) {
+		for ( j = 0; j < 3; j++ ) {
+			rgf[i][j] = ( i == j ) ? 1 : 0;
+			rgp[i][j] = rgq[i][j];
+		}
+	}
+	rgf[0][1] = t;
+	rgf[0][2] = t * t / 2;
+	rgf[1][2] = t;
+
+	for ( iter = 0; iter < cEncObsIter; iter++ ) {
+		// Predict: P = F P F' + Q
+		for ( i = 0; i < 3; i++ ) {
+			for ( j = 0; j < 3; j++ ) {
+				s = 0;
+				for ( l = 0; l < 3; l++ ) {
+					s += rgf[i][l] * rgp[l][j];
+				}
+				rgpp[i][j] = s;
+			}
+		}
+		for ( i = 0; i < 3; i++ ) {
+			for ( j = 0; j < 3; j++ ) {
+				s = rgq[i][j];
+				for ( l = 0; l < 3; l++ ) {
+					s += rgpp[i][l] * rgf[j][l];
+				}
+				rgp[i][j] = s;
+			}
+		}
+
+		// Update on a position measurement: K = P H' / ( H P H' + r )
+		s = rgp[0][0] + r;
+		for ( i = 0; i < 3; i++ ) {
+			rgk[i] = rgp[i][0] / s;
+		}
+		for ( i = 0; i < 3; i++ ) {
+			for ( j = 0; j < 3; j++ ) {
+				rgpp[i][j] = rgp[i][j] - rgk[i] * rgp[0][j];
+			}
+		}
+		for ( i = 0; i < 3; i++ ) {
+			for ( j = 0; j < 3; j++ ) {
+				rgp[i][j] = rgpp[i][j];
+			}
+		}
+
+		// The acceleration gain is the last to settle.
+		s = rgk[2] - kAccPrev;
+		if ( ( s < dkEncObsDone * rgk[2] ) && ( -s < dkEncObsDone * rgk[2] ) ) {
+			break;
+		}
+		kAccPrev = rgk[2];
+	}
+
+	pgain->kPos = Q16FromFloat(rgk[0]);
+	pgain->kSpd = Q16FromFloat(rgk[1] * spdEdge);
+	pgain->kAcc = Q16FromFloat(rgk[2] * spdEdge);
+}
+
+/* ------------------------------------------------------------ */
+/***	EncObsUpdate
+**
+**	Synopsis:
+**		EncObsUpdate(penc, tusNow, cTick, fAnchor, fMeas)
+**
+**	Parameters:
+**		penc    - estimator state for one wheel
+**		tusNow  - end of the window
+**		cTick   - net edges from the previous capture to tusPrev
+**		fAnchor - tusPrev is a capture whose position is not known
+**				  relative to the one before (first edge, prescale
+**				  change)
+**		fMeas   - tusPrev is a new capture at a known position
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		The observer state is kept at the time of the newest capture,
+**		where the wheel position is known exactly. A new capture moves
+**		it forward to the capture and corrects it there; the speed
+**		for the control loops is then carried forward to tusNow.
+**
+**		With no capture in the window the wheel has not reached the
+**		next one, so, as for the M/T speed, it is going no faster than
+**		one capture's worth of edges over the time since the last. A
+**		speed past that is held to it with no acceleration, so it
+**		falls toward zero when the wheel stops. A deceleration that
+**		would carry the speed through zero stops it at zero instead:
+**		without a capture there is nothing to say the wheel reversed.
+**		The state stays at the last capture, and the next one is
+**		corrected with the gains for the whole interval.
+**
+**		An anchor capture restarts the position with no correction.
+*/
+
+static void EncObsUpdate(struct enc * penc, WORD tusNow, int32_t cTick,
+						 BOOL fAnchor, BOOL fMeas)
+{
+	Q16		spdMax;
+	Q16		spd;
+	BOOL	fNeg;
+
+	if ( ! penc->fPrev ) {
+		// Not a single edge yet: the wheel has not moved.
+		return;
+	}
+
+	if ( fAnchor ) {
+		penc->tusObs = penc->tusPrev;
+		penc->edgObs = 0;
+	}
+	else if ( fMeas ) {
+		penc->edgObs -= Q16FromInt(cTick);
+		EncObsCorrect(penc, penc->tusPrev);
+	}
+	else {
+		spd = penc->spdObs + EncDspdQ16(penc->accObs, tusNow - penc->tusObs);
+		spdMax = EncSpeedMtQ16(rgpreEnc[penc->lvlPre].cEdge, tusNow - penc->tusPrev);
+		fNeg = ( penc->spdObs != 0 ) ? ( penc->spdObs < 0 ) : ( spd < 0 );
+		if ( fNeg ? ( spd > 0 ) : ( spd < 0 ) ) {
+			// Slowing down carried it through zero: it stopped.
+			penc->spdObs = 0;
+			penc->accObs = 0;
+		}
+		else if ( ( spd > spdMax ) || ( spd < -spdMax ) ) {
+			penc->spdObs = fNeg ? -spdMax : spdMax;
+			penc->accObs = 0;
+		}
+	}
+
+	penc->spdEst = penc->spdObs + EncDspdQ16(penc->accObs, tusNow - penc->tusObs);
+	penc->accEst = penc->accObs;
+}
+
+/* ------------------------------------------------------------ */
+/***	EncObsPredict
+**
+**	Synopsis:
+**		EncObsPredict(penc, tus)
+**
+**	Parameters:
+**		penc - estimator state for one wheel
+**		tus  - time to move the observer state to
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Carries the observer state forward at constant acceleration.
+*/
+
+static void EncObsPredict(struct enc * penc, WORD tus)
+{
+	WORD	tusDt = tus - penc->tusObs;
+
+	penc->edgObs += EncEdgQ16(penc->spdObs, tusDt) +
+					EncEdgQ16(EncDspdQ16(penc->accObs, tusDt), tusDt) / 2;
+	penc->spdObs += EncDspdQ16(penc->accObs, tusDt);
+	penc->tusObs = tus;
+}
+
+/* ------------------------------------------------------------ */
+/***	EncObsCorrect
+**
+**	Synopsis:
+**		EncObsCorrect(penc, tus)
+**
+**	Parameters:
+**		penc - estimator state for one wheel
+**		tus  - time of a capture at the zero of edgObs
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Predicts the observer state forward to the capture and
+**		corrects it with the position error there, using the gains
+**		for the time since the last correction, interpolated in
+**		rggainEnc.
+*/
+
+static void EncObsCorrect(struct enc * penc, WORD tus)
+{
+	WORD	tusDt = tus - penc->tusObs;
+	WORD	igain;
+	WORD	tusFrac;
+	int32_t	edgErr;
+	Q16		kPos;
+	Q16		kSpd;
+	Q16		kAcc;
+
+	EncObsPredict(penc, tus);
+
+	if ( tusDt <= tusEncObsStep ) {
+		igain = 0;
+		tusFrac = 0;
+	}
+	else {
+		igain = ( tusDt - tusEncObsStep ) / tusEncObsStep;
+		tusFrac = ( tusDt - tusEncObsStep ) % tusEncObsStep;
+		if ( igain >= cEncObsGain - 1 ) {
+			igain = cEncObsGain - 1;
+			tusFrac = 0;
+		}
+	}
+
+	kPos = rggainEnc[igain].kPos;
+	kSpd = rggainEnc[igain].kSpd;
+	kAcc = rggainEnc[igain].kAcc;
+	if ( tusFrac != 0 ) {
+		kPos += ( ( rggainEnc[igain + 1].kPos - kPos ) * (int64_t)tusFrac ) / tusEncObsStep;
+		kSpd += ( ( rggainEnc[igain + 1].kSpd - kSpd ) * (int64_t)tusFrac ) / tusEncObsStep;
+		kAcc += ( ( rggainEnc[igain + 1].kAcc - kAcc ) * (int64_t)tusFrac ) / tusEncObsStep;
+	}
+
+	edgErr = -penc->edgObs;
+	penc->edgObs += Q16Mul(kPos, edgErr);
+	penc->spdObs += Q16Mul(kSpd, edgErr);
+	penc->accObs += Q16Mul(kAcc, edgErr);
+}
+
+/* ------------------------------------------------------------ */
+/***	FEncAccept
+**
+**	Synopsis:
+**		f = FEncAccept(penc, tusDelta)
+**
+**	Parameters:
+**		penc     - estimator state for one wheel
+**		tusDelta - time since the last accepted edge
+**
+**	Return Values:
+**		fTrue if the edge is real, fFalse if it should be dropped
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Validation stage for each edge before it reaches the estimator.
+**		A noise pulse on a hall line shows up as an extra edge shortly
+**		after a real one, i.e. an interval that is too short. Long
+**		intervals are never rejected; a missed edge only makes the
+**		wheel look briefly slower.
+**
+**		Every mode rejects intervals below tusEncGlitch, which would
+**		mean a wheel speed well beyond what the motors can reach.
+**		OPT_ENCFILT 2 also rejects an interval shorter than 1/kEncGate
+**		of the previous accepted interval (a rate of change gate), and
+**		OPT_ENCFILT 3 compares against the median of the last three
+**		accepted intervals instead, so one odd interval does not move
+**		the reference. The reference is capped at tusEncGateRef so a
+**		wheel starting from a stall is not gated against a huge
+**		interval.
+**
+**		After cEncResync rejections in a row the edge is accepted
+**		anyway, so a genuine step in speed cannot lock the wheel out.
+*/
+
+static BOOL FEncAccept(struct enc * penc, WORD tusDelta)
+{
+#if OPT_ENCFILT == 0
+	return fTrue;
+#else
+	WORD	tusRef;
+	BOOL	fOk;
+
+	fOk = ( tusDelta >= tusEncGlitch );
+
+#if OPT_ENCFILT == 2
+	tusRef = penc->rgtusHist[0];
+#elif OPT_ENCFILT == 3
+	tusRef = TusMedian3(penc->rgtusHist[0], penc->rgtusHist[1], penc->rgtusHist[2]);
+#else
+	tusRef = 0;
+#endif
+	if ( tusRef > tusEncGateRef ) {
+		tusRef = tusEncGateRef;
+	}
+	if ( ( tusDelta * kEncGate ) < tusRef ) {
+		fOk = fFalse;
+	}
+
+	if ( ! fOk && ( ++penc->cRejectRun < cEncResync ) ) {
+		return fFalse;
+	}
+
+	penc->rgtusHist[2] = penc->rgtusHist[1];
+	penc->rgtusHist[1] = penc->rgtusHist[0];
+	penc->rgtusHist[0] = tusDelta;
+	penc->cRejectRun = 0;
+	return fTrue;
+#endif
+}
+
+#if OPT_ENCFILT == 3
+/* ------------------------------------------------------------ */
+/***	TusMedian3
+**
+**	Synopsis:
+**		tus = TusMedian3(tus0, tus1, tus2)
+**
+**	Parameters:
+**		tus0, tus1, tus2 - three intervals
+**
+**	Return Values:
+**		the middle value
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Median of three without branching on every ordering.
+*/
+
+static WORD TusMedian3(WORD tus0, WORD tus1, WORD tus2)
+{
+	WORD	tusLo = ( tus0 < tus1 ) ? tus0 : tus1;
+	WORD	tusHi = ( tus0 < tus1 ) ? tus1 : tus0;
+
+	if ( tus2 < tusLo ) {
+		return tusLo;
+	}
+	return ( tus2 < tusHi ) ? tus2 : tusHi;
+}
+#endif
+
+#if OPT_ENCBENCH
+
+/* ------------------------------------------------------------ */
+/***	EncBenchRun
+**
+**	Synopsis:
+**		EncBenchRun()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Times the per-edge speed calculation done by the capture ISRs,
+**		once with the original soft-float code and once with the fixed
+**		point code, over the same spread of edge intervals. The average
+**		number of CPU cycles per edge is left in cycEncFloat and
+**		cycEncFixed to be read with the debugger. Must be called with
+**		interrupts disabled.
+**
+**	Note:
+**		The core timer counts at half the system clock, so elapsed
+**		counts are doubled to get cycles. Loop overhead is included in
+**		both figures.
+*/
+
+void EncBenchRun(void)
+{
+	volatile int	rgtus[cEncBench];
+	volatile float	spdF;
+	volatile float	spdAvgF = 0.0;
+	volatile Q16	spdQ;
+	volatile Q16	spdAvgQ = 0;
+	float			alpha = 0.1;
+	float			beta = 0.9;
+	WORD			tckStart;
+	WORD			tckEnd;
+	int				i;
+
+	// Edge intervals from stall-ish (~100 ms) down to the clamp.
+	for ( i = 0; i < cEncBench; i++ ) {
+		rgtus[i] = 501 + ( i * 391 );
+	}
+
+	tckStart = _CP0_GET_COUNT();
+	for ( i = 0; i < cEncBench; i++ ) {
+		if ( rgtus[i] > 500 )
+			spdF = 5000.0/(float)rgtus[i];
+		else
+			spdF = 2.0;
+		spdAvgF = alpha*spdF + beta*spdAvgF;
+	}
+	tckEnd = _CP0_GET_COUNT();
+	cycEncFloat = ( 2 * ( tckEnd - tckStart ) ) / cEncBench;
+
+	tckStart = _CP0_GET_COUNT();
+	for ( i = 0; i < cEncBench; i++ ) {
+		spdQ = EncSpeedQ16(rgtus[i]);
+		spdAvgQ = EncEmaQ16(spdAvgQ, spdQ);
+	}
+	tckEnd = _CP0_GET_COUNT();
+	cycEncFixed = ( 2 * ( tckEnd - tckStart ) ) / cEncBench;
+}
+
+#endif
+
+/************************************************************************/
@@ -0,0 +1,335 @@
+/************************************************************************/
+/*																		*/
+/*	Encoder.h	--  Wheel Encoder Speed Estimation                      */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for turning input capture edge    */
+/*  intervals from the motor hall sensors into wheel speeds. All of     */
+/*  the per-edge arithmetic is integer so it can run at IPL6 without    */
+/*  calling into the soft-float library.                                */
+/*																		*/
+/*  The capture ISRs only push edge timestamps into a per-wheel ring;   */
+/*  the control tick drains the ring and runs the estimator on every    */
+/*  edge that arrived since the previous tick.                          */
+/*																		*/
+/*  Speed is measured with the M/T method: the number of edges in a     */
+/*  control window divided by the exact time spanned by those edges.    */
+/*  At low speed a window holds one edge and this is the period         */
+/*  method; at high speed it counts many edges over nearly the whole    */
+/*  window. The two cases are the same formula, so the estimate moves   */
+/*  between them without a switch point.                                */
+/*																		*/
+/*  The speed the control loops use comes from an observer run once     */
+/*  per control tick: a steady-state Kalman filter on wheel position,   */
+/*  speed and acceleration. Its measurement is the position of the      */
+/*  last capture at that capture's timestamp, so it sees no edge        */
+/*  quantization, and it predicts with the true time between ticks.     */
+/*  Its time constant is set in seconds by the noise parameters and     */
+/*  does not change with wheel speed.                                   */
+/*																		*/
+/*  Each wheel is one input capture channel. EncChannel() generates     */
+/*  the ISR for a given ICx module and EncChannelInit() configures it;  */
+/*  both expand to straight-line code with the register addresses and   */
+/*  bit positions fixed at compile time.                                */
+/*																		*/
+/*  Direction comes from the second hall output (SB) of each motor,     */
+/*  sampled on every rising edge of SA. Tick counts and speeds are      */
+/*  signed: positive is the direction the robot drives forward.         */
+/*																		*/
+/*  To bound capture interrupt load, the capture mode is switched to    */
+/*  every 4th or every 16th rising edge as the wheel speeds up, and     */
+/*  back as it slows down (OPT_ENCPRE).                                 */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_ENCODER_INC)
+#define _ENCODER_INC
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Timebase.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Speed scaling. Timer 3 ticks once per microsecond, so an edge
+**	interval of tusDelta gives a speed of cusEncSpd / tusDelta ft/s.
+**	(wheelC / 160 edges per revolution is ~4493; 5000 is the value
+**	the controller was tuned with.)
+*/
+#define	cusEncSpd		5000
+
+/*	Speed observer noise (see EncObsGain in Encoder.c). edgEncNoise is
+**	the error in the position of a capture, in edges: magnet spacing
+**	and timestamp jitter. jerkEncNoise is the process noise, the
+**	spectral density of the jerk in ft/s^3 / sqrt(Hz). Raising the
+**	ratio jerk/position widens the observer bandwidth: less lag, more
+**	noise.
+*/
+#define	edgEncNoise		0.1
+#define	jerkEncNoise	20.0
+
+/*	Edge validation (see FEncAccept in Encoder.c). Intervals shorter
+**	than tusEncGlitch are always rejected; with OPT_ENCFILT 2 or 3 an
+**	interval shorter than 1/kEncGate of the reference interval is too.
+*/
+#define	tusEncGlitch	200
+#define	kEncGate		2
+#define	tusEncGateRef	10000
+#define	cEncResync		3
+
+/*	Capture prescale switch points, |observer speed| in ft/s. At
+**	1.5 ft/s a wheel gives 300 edges/s; above 4 ft/s one capture per
+**	16 edges keeps it under 50 captures/s per wheel. The gaps between
+**	up and down points are hysteresis.
+*/
+#define	cEncPre			3		// number of prescale levels
+#define	spdEncPre4Up	Q16FromFloat(1.5)
+#define	spdEncPre4Dn	Q16FromFloat(1.0)
+#define	spdEncPre16Up	Q16FromFloat(4.0)
+#define	spdEncPre16Dn	Q16FromFloat(3.0)
+
+/*	Capture timestamp ring depth. Must be a power of two. The ring
+**	is drained once per control tick and holds cEncRing - 1 captures,
+**	so it must take a whole tick of edges at prescale 1 and the
+**	shortest edge interval, tusEncEdgeMin (10 ft/s, well past the top
+**	wheel speed): 46 at the 43 Hz tick, and the check below fails
+**	for a frqCtrlTick under 32 Hz.
+*/
+#define	tusEncEdgeMin	500
+#define	cEncRing		64
+#define	mskEncRing		( cEncRing - 1 )
+
+#if ( 1000000 / tusEncEdgeMin ) > ( ( cEncRing - 1 ) * frqCtrlTick )
+#error "cEncRing is too small for one control tick at frqCtrlTick"
+#endif
+
+/*	Input capture module bindings. Every ICx module has the same
+**	ICxCON layout; the interrupt bits for ICn are bit 4n+1 of IFS0 and
+**	IEC0 and bits 12:8 of IPCn, and its input pin is RD(7+n).
+*/
+#define	bnIcOn			15	// ICxCON: module enable
+#define	bnIcBne			3	// ICxCON: capture buffer not empty
+#define	bnIcC32			8	// ICxCON: 32-bit capture
+#define	icmEvery1		3	// ICxCON<2:0>: every rising edge
+#define	icmEvery4		4	// ICxCON<2:0>: every 4th rising edge
+#define	icmEvery16		5	// ICxCON<2:0>: every 16th rising edge
+#define	bnIcIf(n)		( ( 4 * (n) ) + 1 )
+#define	bnIcPin(n)		( 7 + (n) )
+
+/*	ICxCON timer selection: 32-bit captures of the Timer 2/3 pair with
+**	OPT_TB32, otherwise 16-bit captures of Timer 3 (ICTMR = 0).
+*/
+#if OPT_TB32
+#define	bitsIcTmr		( 1 << bnIcC32 )
+#else
+#define	bitsIcTmr		0
+#endif
+
+/*	Priority of every encoder capture ISR. iplEnc must match the ipl6
+**	in EncChannel().
+*/
+#define	iplEnc			6
+#define	ipsEnc			3
+
+/*	Single producer (capture ISR) / single consumer (control tick)
+**	ring of 32-bit microsecond edge timestamps, each with the level of
+**	SB at that edge. Only the producer writes iHead and only the
+**	consumer writes iTail, so neither side needs to disable interrupts.
+*/
+struct encring {
+	volatile WORD	iHead;				// next slot the ISR will fill
+	volatile WORD	iTail;				// next slot the tick will read
+	volatile WORD	rgtus[cEncRing];	// edge timestamps, microseconds
+	volatile BYTE	rgstSb[cEncRing];	// SB level at each edge
+	volatile WORD	cDrop;				// edges lost to a full ring
+};
+
+/*	Per-wheel estimator state. Everything below ring is owned by the
+**	control tick. The observer position is kept as an offset from the
+**	last capture, in Q16 edges, so it never grows.
+*/
+struct enc {
+	struct encring	ring;
+	WORD			iHeadSnap;	// ring.iHead at the last EncSnapshot
+	volatile WORD *	picCon;		// ICxCON of this channel
+	BYTE			stSbFwd;	// SB level at an SA edge when going forward
+	BYTE			lvlPre;		// capture prescale level now in hardware
+	WORD			cEdgeCap;	// edges per capture for the ring entries
+								// being drained
+	BOOL			fResync;	// prescale changed at tusResync
+	WORD			tusResync;
+	WORD			tusPrev;	// timestamp of the last processed edge
+	BOOL			fPrev;		// tusPrev is valid
+	int32_t			cTick;		// signed edge count since reset
+	Q16				spd;		// signed M/T speed over the last window
+	Q16				spdEst;		// observer speed at the window end, ft/s
+	Q16				accEst;		// observer acceleration, ft/s^2
+	WORD			tusObs;		// time of the observer state:
+	int32_t			edgObs;		// position past tusPrev, Q16 edges
+	Q16				spdObs;		// ft/s
+	Q16				accObs;		// ft/s^2
+	WORD			rgtusHist[3];	// last accepted intervals, newest first
+	WORD			cRejectRun;	// consecutive rejected edges
+	WORD			cAccept;	// edges accepted since reset
+	WORD			cReject;	// edges rejected as glitches since reset
+};
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	struct enc	encLeft;	// IC2
+extern	struct enc	encRight;	// IC3
+
+#if OPT_ENCBENCH
+extern	WORD	cycEncFloat;	// average cycles per edge, soft-float path
+extern	WORD	cycEncFixed;	// average cycles per edge, fixed point path
+#endif
+
+/* ------------------------------------------------------------ */
+/*					        Macros		        				*/
+/* ------------------------------------------------------------ */
+
+/***	EncSpeedQ16
+**
+**	Converts a single edge interval in microseconds into a speed in
+**	Q16 ft/s. Uses one unsigned 32-bit hardware divide.
+*/
+static inline Q16 EncSpeedQ16(WORD tusDelta)
+{
+	if ( tusDelta == 0 ) {
+		tusDelta = 1;
+	}
+	return (Q16)( ((WORD)cusEncSpd << bnQ16Frac) / tusDelta );
+}
+
+/***	EncSpeedMtQ16
+**
+**	M/T speed: a net signed cTick edges spanning tusSpan microseconds.
+**	Needs a 64-bit numerator once more than one edge is counted.
+*/
+static inline Q16 EncSpeedMtQ16(int32_t cTick, WORD tusSpan)
+{
+	WORD	cEdge = ( cTick < 0 ) ? -cTick : cTick;
+	Q16		spd;
+
+	if ( cEdge == 1 ) {
+		spd = EncSpeedQ16(tusSpan);
+	}
+	else {
+		if ( tusSpan == 0 ) {
+			tusSpan = 1;
+		}
+		spd = (Q16)( ((DWORD)cEdge * ((WORD)cusEncSpd << bnQ16Frac)) / tusSpan );
+	}
+	return ( cTick < 0 ) ? -spd : spd;
+}
+
+/***	EncPush
+**
+**	Called from a capture ISR to queue one edge timestamp and the SB
+**	level. Publishes the slot by advancing iHead only after both are
+**	stored.
+*/
+static inline void EncPush(struct enc * penc, WORD tus, BYTE stSb)
+{
+	WORD	iHead = penc->ring.iHead;
+
+	if ( ((iHead + 1) & mskEncRing) == penc->ring.iTail ) {
+		penc->ring.cDrop++;
+		return;
+	}
+	penc->ring.rgtus[iHead] = tus;
+	penc->ring.rgstSb[iHead] = stSb;
+	penc->ring.iHead = (iHead + 1) & mskEncRing;
+}
+
+/***	EncChannelIsr
+**
+**	Body of every capture ISR: clear the flag and queue each buffered
+**	capture along with the current SB level. A 32-bit capture already
+**	is a timestamp; a 16-bit one is extended by TbCaptureUs. SB is a
+**	quarter period out of phase with SA, so it is stable for well over
+**	the ISR latency after the edge. Only ever called with constant
+**	arguments from EncChannel, so it inlines to the same code as a
+**	hand-written handler.
+*/
+static inline void EncChannelIsr(volatile WORD * picCon, volatile WORD * picBuf,
+								 volatile WORD * pifsClr, WORD bnIf,
+								 volatile WORD * pprtSb, WORD bnSb,
+								 struct enc * penc)
+{
+	WORD	tus;
+
+	*pifsClr = ( 1 << bnIf );
+
+	while ( *picCon & ( 1 << bnIcBne ) ) {
+#if OPT_TB32
+		tus = *picBuf;
+#else
+		// mask off the upper half of the buffer; extend to microseconds
+		tus = (WORD)TbCaptureUs((HWORD)(*picBuf & 0x0000FFFF));
+#endif
+		EncPush(penc, tus, (BYTE)( ( *pprtSb >> bnSb ) & 1 ));
+	}
+}
+
+/***	EncChannel
+**
+**	Defines the capture ISR binding input capture module n and the
+**	SB input on bit bnSb of port prtSb to the estimator state enc.
+*/
+#define	EncChannel(n, prtSb, bnSb, enc)										\
+	void __ISR(_INPUT_CAPTURE_##n##_VECTOR, ipl6) _IC##n##_IntHandler(void)	\
+	{																		\
+		EncChannelIsr(&IC##n##CON, &IC##n##BUF, &IFS0CLR, bnIcIf(n),		\
+					  &(prtSb), (bnSb), &(enc));							\
+	}
+
+/***	EncChannelInit
+**
+**	Configures input capture module n for every-rising-edge capture
+**	on the timebase timer, makes the SB pin an input, sets the
+**	interrupt priority and turns the module on. It is one statement,
+**	so it is safe under an if without braces.
+*/
+#define	EncChannelInit(n, trisSbSet, bnSb, enc)							\
+	do {																\
+		(enc).picCon	= &IC##n##CON;									\
+		(enc).cEdgeCap	= 1;											\
+		TRISDSET		= ( 1 << bnIcPin(n) );							\
+		trisSbSet		= ( 1 << (bnSb) );								\
+		IC##n##CON		= bitsIcTmr | icmEvery1;						\
+		IPC##n##SET		= ( ( iplEnc << 2 ) | ipsEnc ) << 8;			\
+		IFS0CLR			= ( 1 << bnIcIf(n) );							\
+		IEC0SET			= ( 1 << bnIcIf(n) );							\
+		IC##n##CONSET	= ( 1 << bnIcOn );								\
+	} while ( 0 )
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+void	EncInit(void);
+WORD	EncSnapshot(void);
+void	EncUpdate(struct enc * penc, WORD tusNow);
+
+#if OPT_ENCBENCH
+void	EncBenchRun(void);
+#endif
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
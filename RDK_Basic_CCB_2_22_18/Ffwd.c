@@ -0,0 +1,290 @@
+/************************************************************************/
+/*																		*/
+/*	Ffwd.c	--  Speed to Duty Cycle Feedforward                         */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the characterization sweep,    */
+/*  which runs inside the control tick, and for building and looking    */
+/*  up the per-wheel speed to duty tables.                              */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Pwm.h"
+#include "Control.h"
+#include "Ffwd.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+/*	Step lengths in control ticks, rounded, at least one tick each.
+*/
+#define	CFfwdTick(tus)	( ( (tus) + tusCtrlTick / 2 ) / tusCtrlTick )
+#define	cTickSettle		( CFfwdTick(tusFfwdSettle) > 0 ? CFfwdTick(tusFfwdSettle) : 1 )
+#define	cTickMeasure	( CFfwdTick(tusFfwdMeasure) > 0 ? CFfwdTick(tusFfwdMeasure) : 1 )
+
+/*	Duty cycle of sweep step ipt.
+*/
+#define	DtcFfwdStep(ipt)	Q16FromInt( ( (ipt) * dtcPwmMax ) / ( cFfwdPt - 1 ) )
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+struct ffwd	ffwdLeft;
+struct ffwd	ffwdRight;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+static	volatile BOOL	fSweepReq = fFalse;
+static	volatile BOOL	fSweepRun = fFalse;
+static	WORD			iptSweep;
+static	WORD			cTickStep;
+static	int64_t			spdSumLeft;
+static	int64_t			spdSumRight;
+static	Q16				rgspdSweepLeft[cFfwdPt];	// measured, per step
+static	Q16				rgspdSweepRight[cFfwdPt];
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	void	FfwdBuild(struct ffwd * pffwd, const Q16 * rgspdSweep);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	FfwdDuty
+**
+**	Synopsis:
+**		dtc = FfwdDuty(pffwd, spd)
+**
+**	Parameters:
+**		pffwd - table of the wheel
+**		spd   - signed speed setpoint, ft/s
+**
+**	Return Values:
+**		feedforward duty cycle in Q16, with the sign of spd
+**
+**	Errors:
+**		returns 0 if the wheel has no table
+**
+**	Description:
+**		Interpolates linearly between table points. Speeds above the
+**		last point get the last duty; the PID covers the rest.
+**		Reverse is taken as the mirror image of forward.
+*/
+
+Q16 FfwdDuty(struct ffwd * pffwd, Q16 spd)
+{
+	BOOL	fNeg = ( spd < 0 );
+	Q16		dtc;
+	WORD	ipt;
+
+	if ( ( pffwd->cPt == 0 ) || ( spd == 0 ) ) {
+		return 0;
+	}
+	if ( fNeg ) {
+		spd = -spd;
+	}
+
+	if ( spd >= pffwd->rgspd[pffwd->cPt - 1] ) {
+		dtc = pffwd->rgdtc[pffwd->cPt - 1];
+	}
+	else {
+		for ( ipt = 1; pffwd->rgspd[ipt] <= spd; ipt++ ) {
+		}
+		dtc = pffwd->rgdtc[ipt - 1] + (Q16)(
+				( (int64_t)( pffwd->rgdtc[ipt] - pffwd->rgdtc[ipt - 1] ) *
+				  ( spd - pffwd->rgspd[ipt - 1] ) ) /
+				( pffwd->rgspd[ipt] - pffwd->rgspd[ipt - 1] ) );
+	}
+
+	return fNeg ? -dtc : dtc;
+}
+
+/* ------------------------------------------------------------ */
+/***	FfwdSweepStart
+**
+**	Synopsis:
+**		FfwdSweepStart()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Asks the control tick to run a characterization sweep. The
+**		sweep starts at the next tick; a request made while one is
+**		running is ignored.
+*/
+
+void FfwdSweepStart(void)
+{
+	if ( !fSweepRun ) {
+		fSweepReq = fTrue;
+	}
+}
+
+/* ------------------------------------------------------------ */
+/***	FFfwdSweeping
+**
+**	Synopsis:
+**		f = FFfwdSweeping()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		fTrue if a sweep is requested or running
+**
+**	Errors:
+**		none
+*/
+
+BOOL FFfwdSweeping(void)
+{
+	return fSweepReq || fSweepRun;
+}
+
+/* ------------------------------------------------------------ */
+/***	FFfwdSweepTick
+**
+**	Synopsis:
+**		f = FFfwdSweepTick(spdLeft, spdRight, pdtc)
+**
+**	Parameters:
+**		spdLeft  - left wheel speed this tick, ft/s
+**		spdRight - right wheel speed this tick, ft/s
+**		pdtc     - receives the duty cycle for both motors, Q16
+**
+**	Return Values:
+**		fTrue if the sweep owns the motors this tick
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Called once per control tick. While a sweep runs, holds each
+**		duty step for cTickSettle ticks, then averages the speeds
+**		over cTickMeasure ticks. After the last step both tables are
+**		rebuilt and the motors are given a duty of 0 for one tick.
+*/
+
+BOOL FFfwdSweepTick(Q16 spdLeft, Q16 spdRight, Q16 * pdtc)
+{
+	if ( !fSweepRun ) {
+		if ( !fSweepReq ) {
+			return fFalse;
+		}
+		fSweepReq	= fFalse;
+		fSweepRun	= fTrue;
+		iptSweep	= 0;
+		cTickStep	= 0;
+		spdSumLeft	= 0;
+		spdSumRight	= 0;
+	}
+
+	cTickStep++;
+	if ( cTickStep > cTickSettle ) {
+		spdSumLeft += spdLeft;
+		spdSumRight += spdRight;
+	}
+
+	if ( cTickStep >= cTickSettle + cTickMeasure ) {
+		rgspdSweepLeft[iptSweep] = (Q16)( spdSumLeft / cTickMeasure );
+		rgspdSweepRight[iptSweep] = (Q16)( spdSumRight / cTickMeasure );
+		cTickStep	= 0;
+		spdSumLeft	= 0;
+		spdSumRight	= 0;
+		iptSweep++;
+
+		if ( iptSweep >= cFfwdPt ) {
+			FfwdBuild(&ffwdLeft, rgspdSweepLeft);
+			FfwdBuild(&ffwdRight, rgspdSweepRight);
+			fSweepRun = fFalse;
+			*pdtc = 0;
+			return fTrue;
+		}
+	}
+
+	*pdtc = DtcFfwdStep(iptSweep);
+	return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***	FfwdBuild
+**
+**	Synopsis:
+**		FfwdBuild(pffwd, rgspdSweep)
+**
+**	Parameters:
+**		pffwd      - table to fill
+**		rgspdSweep - speed measured at each sweep step
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		leaves an empty table if the wheel never moved
+**
+**	Description:
+**		Step 0 and the leading steps that did not move the wheel
+**		collapse into the first point (0 ft/s, highest such duty),
+**		so a step 0 that read as moving is dropped. After that only
+**		steps faster than every earlier one are kept, so the table
+**		can be inverted even if a step measured slow.
+*/
+
+static void FfwdBuild(struct ffwd * pffwd, const Q16 * rgspdSweep)
+{
+	WORD	ipt = 0;
+	WORD	cPt;
+
+	while ( ( ipt < cFfwdPt ) && ( rgspdSweep[ipt] < spdFfwdMove ) ) {
+		ipt++;
+	}
+
+	// Step 0 is duty 0 and is point 0 even if the wheel was coasting,
+	// so there are never more than cFfwdPt points.
+	if ( ipt == 0 ) {
+		ipt = 1;
+	}
+
+	pffwd->rgspd[0] = 0;
+	pffwd->rgdtc[0] = DtcFfwdStep(ipt - 1);
+	cPt = 1;
+
+	for ( ; ipt < cFfwdPt; ipt++ ) {
+		if ( rgspdSweep[ipt] > pffwd->rgspd[cPt - 1] ) {
+			pffwd->rgspd[cPt] = rgspdSweep[ipt];
+			pffwd->rgdtc[cPt] = DtcFfwdStep(ipt);
+			cPt++;
+		}
+	}
+
+	pffwd->cPt = ( cPt > 1 ) ? cPt : 0;
+}
+
+/************************************************************************/
@@ -0,0 +1,76 @@
+/************************************************************************/
+/*																		*/
+/*	Ffwd.h	--  Speed to Duty Cycle Feedforward                         */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for the per-wheel feedforward     */
+/*  tables and the characterization sweep that builds them. The sweep   */
+/*  steps both motors through cFfwdPt duty cycles from 0 to dtcPwmMax,  */
+/*  lets each step settle, and averages the measured speed. The result  */
+/*  is made monotonic and inverted into a speed to duty table, which    */
+/*  the control tick adds to the PID output, so the PID only has to     */
+/*  correct what the table gets wrong.                                  */
+/*																		*/
+/*  The sweep drives the robot forward for a few seconds at up to full  */
+/*  speed; run it with room to drive, since the speeds on the floor     */
+/*  are the ones the controller needs.                                  */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_FFWD_INC)
+#define _FFWD_INC
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Sweep shape: duty steps, and the time each step settles before
+**	and is measured after. Speeds below spdFfwdMove count as stopped.
+*/
+#define	cFfwdPt			12
+#define	tusFfwdSettle	300000
+#define	tusFfwdMeasure	300000
+#define	spdFfwdMove		Q16FromFloat(0.05)
+
+/*	Speed to duty table for one wheel. rgspd is strictly increasing
+**	from rgspd[0] = 0; rgdtc[0] is the highest duty that did not move
+**	the wheel. cPt = 0 means no table (zero feedforward).
+*/
+struct ffwd {
+	WORD	cPt;
+	Q16		rgspd[cFfwdPt];		// ft/s
+	Q16		rgdtc[cFfwdPt];		// OC duty
+};
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	struct ffwd	ffwdLeft;
+extern	struct ffwd	ffwdRight;
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+Q16		FfwdDuty(struct ffwd * pffwd, Q16 spd);
+void	FfwdSweepStart(void);
+BOOL	FFfwdSweepTick(Q16 spdLeft, Q16 spdRight, Q16 * pdtc);
+BOOL	FFfwdSweeping(void);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
@@ -0,0 +1,264 @@
+/************************************************************************/
+/*																		*/
+/*	Fric.c	--  Motor Static Friction Compensation                      */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the breakaway pulses and the   */
+/*  learned sustaining duty of each wheel.                              */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Pid.h"
+#include "Pwm.h"
+#include "Fric.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	tusPerSec		1000000
+#define	dtcFricFull		Q16FromInt(dtcPwmMax)
+
+#define	FricMin(a, b)	( ( (a) < (b) ) ? (a) : (b) )
+#define	FricMax(a, b)	( ( (a) > (b) ) ? (a) : (b) )
+#define	FricDir(fNeg, q)	( (fNeg) ? -(q) : (q) )
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+struct fric	fricLeft;
+struct fric	fricRight;
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	void	FricPulseStart(struct fric * pfric);
+static	WORD	CTickFric(WORD tus, WORD tusTick);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	FricInit
+**
+**	Synopsis:
+**		FricInit(pfric, tusTick)
+**
+**	Parameters:
+**		pfric   - friction state of one wheel
+**		tusTick - period between calls to FricUpdate, microseconds
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Converts the times to ticks and starts the learned duties at
+**		dtcFricHold and dtcFricBrk.
+*/
+
+void FricInit(struct fric * pfric, WORD tusTick)
+{
+	pfric->st			= stFricIdle;
+	pfric->fNeg			= fFalse;
+	pfric->cTick		= 0;
+	pfric->cTickStall	= CTickFric(tusFricStall, tusTick);
+	pfric->cTickPulse	= CTickFric(tusFricPulse, tusTick);
+	pfric->dtcLeakTick	= (Q16)( ( (int64_t)dtcFricLeak * tusTick ) / tusPerSec );
+	pfric->dtcBrk		= dtcFricBrk;
+	pfric->dtcHold		= dtcFricHold;
+	pfric->cBrk			= 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	FricUpdate
+**
+**	Synopsis:
+**		dtc = FricUpdate(pfric, ppid, spdCmd, spd, ff)
+**
+**	Parameters:
+**		pfric  - friction state of the wheel
+**		ppid   - speed PID of the wheel
+**		spdCmd - commanded speed, ft/s, signed
+**		spd    - measured speed, ft/s
+**		ff     - feedforward duty for the PID
+**
+**	Return Values:
+**		signed OC duty for the wheel
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Works in the direction of the command. Runs the wheel PID
+**		with its output held at least the sustaining duty that way
+**		while a speed is commanded, and over the whole range either
+**		way otherwise, and resets it once the wheel has stopped with
+**		no command. Holds the output at the breakaway duty or more
+**		during a pulse. A command that changes direction starts over
+**		as from rest.
+**		The pulse bypasses the PID rather than raising its limit,
+**		so the integral is not pushed up to the breakaway duty and
+**		the wheel does not jump once it is free.
+*/
+
+Q16 FricUpdate(struct fric * pfric, struct pid * ppid, Q16 spdCmd, Q16 spd, Q16 ff)
+{
+	BOOL	fNeg = ( spdCmd < 0 );
+	BOOL	fStopped;
+	BOOL	fLow;
+	Q16		dtc;
+
+	// From here on speeds and duties are positive the way of the command.
+	spdCmd = FricDir(fNeg, spdCmd);
+	spd = FricDir(fNeg, spd);
+	fStopped = ( spd < spdFricStall ) && ( spd > -spdFricStall );
+	fLow = ( spdCmd < spdFricLow );
+
+	if ( spdCmd < spdFricCmd ) {
+		pfric->st = stFricIdle;
+		if ( fStopped ) {
+			// Drop what is left of the integral so the wheel stays put.
+			PidReset(ppid);
+			return 0;
+		}
+	}
+	else {
+		if ( fNeg != pfric->fNeg ) {
+			pfric->fNeg = fNeg;
+			pfric->st = stFricIdle;
+		}
+
+		switch ( pfric->st ) {
+			case stFricIdle:
+				// A command from rest starts with a pulse.
+				if ( fStopped ) {
+					FricPulseStart(pfric);
+				}
+				else {
+					pfric->st = stFricRun;
+					pfric->cTick = 0;
+				}
+				break;
+
+			case stFricRun:
+				if ( ! fStopped ) {
+					pfric->cTick = 0;
+				}
+				else if ( fLow && ( ++pfric->cTick >= pfric->cTickStall ) ) {
+					// Whatever it stalled at was not enough to keep it turning.
+					pfric->dtcHold = FricMin(FricMax(pfric->dtcHold, FricDir(fNeg, ppid->out)) +
+											 dtcFricStep, dtcFricMax);
+					FricPulseStart(pfric);
+				}
+				break;
+
+			case stFricPulse:
+				if ( --pfric->cTick != 0 ) {
+					break;
+				}
+				if ( fStopped ) {
+					pfric->dtcBrk = FricMin(pfric->dtcBrk + dtcFricStep, dtcFricMax);
+					FricPulseStart(pfric);
+				}
+				else {
+					pfric->dtcBrk = FricMax(pfric->dtcBrk - dtcFricStep / 4, pfric->dtcHold);
+					pfric->st = stFricRun;
+				}
+				break;
+
+			default:
+				pfric->st = stFricIdle;
+				break;
+		}
+	}
+
+	if ( pfric->st == stFricIdle ) {
+		PidSetLimits(ppid, -dtcFricFull, dtcFricFull);
+	}
+	else if ( fNeg ) {
+		PidSetLimits(ppid, -dtcFricFull, -pfric->dtcHold);
+	}
+	else {
+		PidSetLimits(ppid, pfric->dtcHold, dtcFricFull);
+	}
+	dtc = FricDir(fNeg, PidUpdate(ppid, FricDir(fNeg, spdCmd - spd), ff));
+
+	if ( pfric->st == stFricRun ) {
+		if ( fLow && ( spd >= spdFricStall ) && ( dtc <= pfric->dtcHold ) ) {
+			// On the floor and still turning: the floor can come down.
+			pfric->dtcHold = FricMax(pfric->dtcHold - pfric->dtcLeakTick, 0);
+		}
+	}
+	else if ( pfric->st == stFricPulse ) {
+		dtc = FricMax(dtc, pfric->dtcBrk);
+	}
+
+	return FricDir(fNeg, dtc);
+}
+
+/* ------------------------------------------------------------ */
+/***	FricPulseStart
+**
+**	Synopsis:
+**		FricPulseStart(pfric)
+**
+**	Parameters:
+**		pfric - friction state of one wheel
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+*/
+
+static void FricPulseStart(struct fric * pfric)
+{
+	pfric->st = stFricPulse;
+	pfric->cTick = pfric->cTickPulse;
+	pfric->cBrk++;
+}
+
+/* ------------------------------------------------------------ */
+/***	CTickFric
+**
+**	Synopsis:
+**		cTick = CTickFric(tus, tusTick)
+**
+**	Parameters:
+**		tus     - time, microseconds
+**		tusTick - tick period, microseconds
+**
+**	Return Values:
+**		tus in whole ticks, at least one
+**
+**	Errors:
+**		none
+*/
+
+static WORD CTickFric(WORD tus, WORD tusTick)
+{
+	WORD	cTick = ( tus + tusTick / 2 ) / tusTick;
+
+	return ( cTick == 0 ) ? 1 : cTick;
+}
+
+/************************************************************************/
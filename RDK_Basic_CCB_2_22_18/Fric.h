@@ -0,0 +1,106 @@
+/************************************************************************/
+/*																		*/
+/*	Fric.h	--  Motor Static Friction Compensation                      */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for breaking each wheel away      */
+/*  from static friction and keeping it turning at low speed. A gear    */
+/*  motor needs more duty to start than to keep going, so a PID that    */
+/*  brings a stopped wheel up from zero winds up until it breaks free   */
+/*  and then overshoots, and at low setpoints it stalls and starts      */
+/*  over. Per wheel, while a speed is commanded, in its direction:      */
+/*																		*/
+/*  - A stopped wheel gets a breakaway pulse: the duty is held at       */
+/*    least dtcBrk for tusFricPulse. A pulse that leaves the wheel      */
+/*    stopped raises dtcBrk and is repeated; one that frees it lowers   */
+/*    dtcBrk a little, so it settles on the least duty that works.      */
+/*																		*/
+/*  - A turning wheel's PID is floored at dtcHold, the sustaining       */
+/*    duty. At low commands, while the PID sits on the floor with the   */
+/*    wheel still turning, dtcHold creeps down; a stall raises it past  */
+/*    the duty the wheel stalled at and triggers a pulse. It settles    */
+/*    just above the least duty that keeps the wheel moving.            */
+/*																		*/
+/*  With no speed commanded the PID may drive either way, so the wheel  */
+/*  is braked to a stop, and a command that changes direction starts    */
+/*  over as from rest. The learned duties are kept across moves, and    */
+/*  can be read in the debugger and put back as the starting values.    */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_FRIC_INC)
+#define _FRIC_INC
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Pid.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Commands below spdFricCmd mean stop. A wheel slower than
+**	spdFricStall is stopped; one that stays so for tusFricStall while
+**	commanded has stalled. Stalls and floor learning only count below
+**	spdFricLow: above it the PID has the duty well clear of friction.
+*/
+#define	spdFricCmd		Q16FromFloat(0.02)	// ft/s
+#define	spdFricStall	Q16FromFloat(0.03)
+#define	spdFricLow		Q16FromFloat(0.5)
+#define	tusFricStall	70000
+#define	tusFricPulse	50000
+
+/*	Starting values and limits of the learned duties, OC duty. The
+**	sustaining duty starts at the old fixed PID floor.
+*/
+#define	dtcFricHold		Q16FromInt(800)
+#define	dtcFricBrk		Q16FromInt(2000)
+#define	dtcFricMax		Q16FromInt(5000)
+#define	dtcFricStep		Q16FromInt(100)		// per stall or failed pulse
+#define	dtcFricLeak		Q16FromInt(100)		// per second on the floor
+
+/*	Friction states.
+*/
+#define	stFricIdle		0		// no speed commanded
+#define	stFricRun		1
+#define	stFricPulse		2
+
+struct fric {
+	BYTE	st;
+	BOOL	fNeg;			// command is backward
+	WORD	cTick;			// ticks stopped, or left in the pulse
+	WORD	cTickStall;		// tusFricStall in ticks
+	WORD	cTickPulse;		// tusFricPulse in ticks
+	Q16		dtcLeakTick;	// dtcFricLeak per tick
+	Q16		dtcBrk;			// learned breakaway duty
+	Q16		dtcHold;		// learned sustaining duty
+	WORD	cBrk;			// breakaway pulses since init
+};
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	struct fric	fricLeft;
+extern	struct fric	fricRight;
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+void	FricInit(struct fric * pfric, WORD tusTick);
+Q16		FricUpdate(struct fric * pfric, struct pid * ppid, Q16 spdCmd, Q16 spd, Q16 ff);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
@@ -0,0 +1,356 @@
+/************************************************************************/
+/*																		*/
+/*	Move.c	--  Encoder Closed Loop Move Primitives                     */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the drive and turn moves and   */
+/*  for the position loop the control tick runs for them.               */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <plib.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Encoder.h"
+#include "Odom.h"
+#include "Control.h"
+#include "Move.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+/*	Wheel arc per degree of turn in place, Q16 feet.
+*/
+#define	ftMoveDeg		Q16FromFloat(3.141592653589793 / 180.0 * ftOdomTrack / 2.0)
+
+#define	MoveAbs(q)		( ( (q) < 0 ) ? -(q) : (q) )
+
+/*	Distance left ft is within tolerance, or it or the travel still to
+**	come (the lag travel, ftLag) would get there.
+*/
+#define	FMoveArrived(ft)		( MoveAbs(ft) <= ftMoveTol )
+#define	FMoveStopping(ft, ftLag)	( FMoveArrived(ft) || FMoveArrived(ftLag) ||		\
+								  ( ( (ftLag) < 0 ) != ( (ft) < 0 ) ) )
+
+#define	secMoveLag		Q16FromFloat(tusMoveLag / 1000000.0)
+
+#define	MoveMax(a, b)	( ( (a) > (b) ) ? (a) : (b) )
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+struct move	move;
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	BOOL	FMoveStart(BYTE mode, Q16 ftGoal, Q16 spd);
+static	WORD	CTickMoveBudget(Q16 ftGoal, Q16 spd);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	FMoveDrive
+**
+**	Synopsis:
+**		f = FMoveDrive(ft, spd)
+**
+**	Parameters:
+**		ft  - distance, feet; negative drives backward
+**		spd - cruise speed, ft/s
+**
+**	Return Values:
+**		fTrue if the move was started
+**
+**	Errors:
+**		fails if a move is already in progress
+**
+**	Description:
+**		Drives straight; the wheel cross-coupling holds the heading.
+*/
+
+BOOL FMoveDrive(Q16 ft, Q16 spd)
+{
+	return FMoveStart(modeMoveDrive, ft, spd);
+}
+
+/* ------------------------------------------------------------ */
+/***	FMoveTurn
+**
+**	Synopsis:
+**		f = FMoveTurn(deg, spd)
+**
+**	Parameters:
+**		deg - angle, degrees; counterclockwise positive
+**		spd - cruise wheel speed, ft/s
+**
+**	Return Values:
+**		fTrue if the move was started
+**
+**	Errors:
+**		fails if a move is already in progress
+**
+**	Description:
+**		Turns in place, the wheels running in opposite directions.
+*/
+
+BOOL FMoveTurn(Q16 deg, Q16 spd)
+{
+	return FMoveStart(modeMoveTurn, Q16Mul(deg, ftMoveDeg), spd);
+}
+
+/* ------------------------------------------------------------ */
+/***	FMoveBusy
+**
+**	Synopsis:
+**		f = FMoveBusy()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		fTrue while a move is running
+**
+**	Errors:
+**		none
+*/
+
+BOOL FMoveBusy(void)
+{
+	return move.st == stMoveRun;
+}
+
+/* ------------------------------------------------------------ */
+/***	FMoveFailed
+**
+**	Synopsis:
+**		f = FMoveFailed()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		fTrue if the last move ran out of its tick budget
+**
+**	Errors:
+**		none
+*/
+
+BOOL FMoveFailed(void)
+{
+	return move.st == stMoveFail;
+}
+
+/* ------------------------------------------------------------ */
+/***	MoveAbort
+**
+**	Synopsis:
+**		MoveAbort()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Ends any move and brings both wheels to a stop through the
+**		setpoint profiles.
+*/
+
+void MoveAbort(void)
+{
+	unsigned int	st;
+
+	st = INTDisableInterrupts();
+	move.st		= stMoveIdle;
+	spdSetLeft	= 0;
+	spdSetRight	= 0;
+	INTRestoreInterrupts(st);
+}
+
+/* ------------------------------------------------------------ */
+/***	MoveTick
+**
+**	Synopsis:
+**		MoveTick()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Called by the control tick, after the encoder update and
+**		before the setpoint profiles. Sets spdSetLeft and spdSetRight
+**		while a move is in progress. Once the lag travel would reach
+**		the goal the setpoints drop to zero and the wheel loops brake;
+**		if the robot stops short, or past the goal, the speed law
+**		picks up again toward it, backing up if need be. The move
+**		ends when the distance left is within ftMoveTol with the
+**		robot all but stopped, or fails, with the setpoints at zero,
+**		when its tick budget runs out first.
+*/
+
+void MoveTick(void)
+{
+	Q16		ftDone;
+	Q16		spd;
+	Q16		spdNow;
+
+	if ( move.st != stMoveRun ) {
+		return;
+	}
+
+	if ( move.mode == modeMoveDrive ) {
+		ftDone = OdomFtQ16( ( encLeft.cTick - move.cTickLeft ) +
+							( encRight.cTick - move.cTickRight ) ) / 2;
+		spdNow = ( encLeft.spdEst + encRight.spdEst ) / 2;
+	}
+	else {
+		ftDone = OdomFtQ16( ( encRight.cTick - move.cTickRight ) -
+							( encLeft.cTick - move.cTickLeft ) ) / 2;
+		spdNow = ( encRight.spdEst - encLeft.spdEst ) / 2;
+	}
+	move.ftRem = move.ftGoal - ftDone;
+	move.ftRemLag = move.ftRem - Q16Mul(spdNow, secMoveLag);
+
+	if ( FMoveArrived(move.ftRem) && ( MoveAbs(spdNow) <= spdMoveRest ) ) {
+		spdSetLeft	= 0;
+		spdSetRight	= 0;
+		move.st		= stMoveIdle;
+		return;
+	}
+	if ( move.cTickBudget == 0 ) {
+		spdSetLeft	= 0;
+		spdSetRight	= 0;
+		move.st		= stMoveFail;
+		return;
+	}
+	move.cTickBudget--;
+
+	if ( FMoveStopping(move.ftRem, move.ftRemLag) ) {
+		// Stopping will get there; creep on if it falls short or over.
+		spdSetLeft	= 0;
+		spdSetRight	= 0;
+		return;
+	}
+
+	spd = Q16Sqrt(Q16Mul(2 * accMove, MoveAbs(move.ftRemLag)));
+	if ( spd > move.spdMax ) {
+		spd = move.spdMax;
+	}
+	if ( spd < spdMoveMin ) {
+		spd = spdMoveMin;
+	}
+	if ( move.ftRemLag < 0 ) {
+		spd = -spd;
+	}
+
+	spdSetLeft	= ( move.mode == modeMoveDrive ) ? spd : -spd;
+	spdSetRight	= spd;
+}
+
+/* ------------------------------------------------------------ */
+/***	FMoveStart
+**
+**	Synopsis:
+**		f = FMoveStart(mode, ftGoal, spd)
+**
+**	Parameters:
+**		mode   - modeMoveDrive or modeMoveTurn
+**		ftGoal - signed wheel travel, feet
+**		spd    - cruise speed, ft/s
+**
+**	Return Values:
+**		fTrue if the move was started
+**
+**	Errors:
+**		fails if a move is already in progress
+**
+**	Description:
+**		Distances are counted from the wheel counts now. The robot
+**		need not be at rest; if it is moving the wrong way the speed
+**		law brings it round through zero.
+*/
+
+static BOOL FMoveStart(BYTE mode, Q16 ftGoal, Q16 spd)
+{
+	unsigned int	st;
+	BOOL			fStart = fFalse;
+
+	st = INTDisableInterrupts();
+	if ( move.st != stMoveRun ) {
+		move.mode	= mode;
+		move.ftGoal	= ftGoal;
+		move.spdMax	= MoveAbs(spd);
+		move.cTickLeft	= encLeft.cTick;
+		move.cTickRight	= encRight.cTick;
+		move.ftRem		= ftGoal;
+		move.ftRemLag	= ftGoal;
+		move.cTickBudget	= CTickMoveBudget(ftGoal, spd);
+		move.st		= stMoveRun;
+		fStart		= fTrue;
+	}
+	INTRestoreInterrupts(st);
+
+	return fStart;
+}
+
+/* ------------------------------------------------------------ */
+/***	CTickMoveBudget
+**
+**	Synopsis:
+**		ctick = CTickMoveBudget(ftGoal, spd)
+**
+**	Parameters:
+**		ftGoal - signed wheel travel, feet
+**		spd    - cruise speed, ft/s
+**
+**	Return Values:
+**		control ticks the move may take
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		The expected time is the distance at the cruise speed plus
+**		the time to reach that speed and to brake from it at accMove,
+**		which covers the profile lag too. The cruise speed is taken
+**		as at least spdMoveMin, the speed law's floor.
+*/
+
+static WORD CTickMoveBudget(Q16 ftGoal, Q16 spd)
+{
+	Q16		spdCruise = MoveMax(MoveAbs(spd), spdMoveMin);
+	int64_t	sec;
+
+	sec = ( ( (int64_t)MoveAbs(ftGoal) << bnQ16Frac ) / spdCruise ) +
+		  ( ( (int64_t)spdCruise << bnQ16Frac ) / accMove );
+
+	return (WORD)( ( ( ( 2 * sec + secMoveSlack ) * 1000000 ) / tusCtrlTick ) >> bnQ16Frac ) + 1;
+}
+
+/************************************************************************/
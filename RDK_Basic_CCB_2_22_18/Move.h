@@ -0,0 +1,112 @@
+/************************************************************************/
+/*																		*/
+/*	Move.h	--  Encoder Closed Loop Move Primitives                     */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for "drive N feet" and "turn N    */
+/*  degrees". A move is an outer position loop over the wheel speed     */
+/*  loops: every control tick it measures the distance still to go      */
+/*  from the encoder counts and sets the wheel speed setpoints to       */
+/*                                                                      */
+/*		min( spd, sqrt(2 accMove remaining) )                           */
+/*                                                                      */
+/*  which is the speed from which the robot can just stop in the        */
+/*  distance left at accMove. The distance is taken from where the      */
+/*  robot will be once the wheels catch up with their setpoints, so it  */
+/*  does not arrive still moving. The move ends on the encoder counts,  */
+/*  within ftMoveTol, so it covers the same ground whatever the battery */
+/*  level or floor friction.                                            */
+/*																		*/
+/*  The wheel loops are signed, so a move that overshoots backs up to   */
+/*  the goal, and a move may start while the robot is still moving.     */
+/*  Turns are in place, counterclockwise positive, measured on the      */
+/*  wheel arc. Start a move from the main loop and poll FMoveBusy.      */
+/*																		*/
+/*  Each move has a tick budget, twice the time the speed law should    */
+/*  take plus secMoveSlack. A move that has not ended by then, with a   */
+/*  stalled wheel or one hunting around the goal, stops the wheels and  */
+/*  ends in stMoveFail, which FMoveFailed reports.                      */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_MOVE_INC)
+#define _MOVE_INC
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Braking deceleration; keep it below accProfWheel so the setpoint
+**	profile can follow the braking curve. Near the end the speed is
+**	held at spdMoveMin so the wheels do not stall short.
+*/
+#define	accMove			Q16FromFloat(1.0)	// ft/s^2
+#define	spdMoveMin		Q16FromFloat(0.1)	// ft/s
+#define	ftMoveTol		Q16FromFloat(0.01)	// ft, about two ticks
+#define	spdMoveRest		Q16FromFloat(0.05)	// ft/s, wheels at rest
+
+/*	The wheels trail the braking curve by the setpoint profile and the
+**	speed loop; the position loop works from where the robot will be
+**	after that lag at the measured speed, so that it does not arrive
+**	still moving.
+*/
+#define	tusMoveLag		150000
+
+/*	Time allowed on top of twice the expected move time.
+*/
+#define	secMoveSlack	Q16FromFloat(2.0)
+
+/*	Move states.
+*/
+#define	stMoveIdle		0		// no move, or the last one arrived
+#define	stMoveRun		1
+#define	stMoveFail		2		// the last move ran out of ticks
+
+#define	modeMoveDrive	0
+#define	modeMoveTurn	1
+
+struct move {
+	volatile BYTE	st;
+	BYTE	mode;
+	Q16		ftGoal;			// signed distance, feet of wheel travel
+	Q16		spdMax;			// cruise speed, ft/s
+	int32_t	cTickLeft;		// wheel counts at the start of the move
+	int32_t	cTickRight;
+	Q16		ftRem;			// distance still to go
+	Q16		ftRemLag;		// the same, less the lag travel
+	WORD	cTickBudget;	// ticks left before the move fails
+};
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	struct move	move;
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+BOOL	FMoveDrive(Q16 ft, Q16 spd);
+BOOL	FMoveTurn(Q16 deg, Q16 spd);
+BOOL	FMoveBusy(void);
+BOOL	FMoveFailed(void);
+void	MoveAbort(void);
+void	MoveTick(void);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
@@ -28,6 +28,7 @@
 #include "config.h"
 #include "stdtypes.h"
 #include "MtrCtrl.h"
+#include "Pwm.h"
 
 /* ------------------------------------------------------------ */
 /*				Local Type Definitions							*/
@@ -43,9 +44,6 @@
 /*				Local Variables									*/
 /* ------------------------------------------------------------ */
 
-const		HWORD	rgtusMtr[] = { 1, 10, 50, 100, 500, 1000, 2000 };
-const		HWORD	rgdtcMtr[] = { 0,  1,  5,  10,  20,   30,   40 };
-
 /* ------------------------------------------------------------ */
 /*				Forward Declarations							*/
 /* ------------------------------------------------------------ */
@@ -78,7 +76,9 @@ void    UpdateMotors();  //loads new values into OCRs
 **
 **	Description:
 **		Updates Output Compare Registers with values to drive motors
-**		as well as updating motor direction bits.
+**		as well as updating motor direction bits. The duty cycles are
+**		passed to PwmSet signed by direction; it stops a motor for a
+**		PWM period before reversing it.
 */
 
 /* ------------------------------------------------------------ */
@@ -86,32 +86,11 @@ void    UpdateMotors();  //loads new values into OCRs
 /* ------------------------------------------------------------ */
 
 void    UpdateMotors(){  //loads new values into OCRs
-	
-	OC3R 	= dtcMtrStopped;   // this block 
-	OC3RS	= dtcMtrStopped;
-	OC2R	= dtcMtrStopped;
-	OC2RS	= dtcMtrStopped;
-
-	if(dirMtrLeft){
-		trisMtrLeftDirClr	= ( 1 << bnMtrLeftDir );
-		prtMtrLeftDirClr	= ( 1 << bnMtrLeftDir );	// forward
-	}else if(!dirMtrLeft){
-		trisMtrLeftDirClr	= ( 1 << bnMtrLeftDir );
-		prtMtrLeftDirSet	= ( 1 << bnMtrLeftDir );	// backward
-	}
-
-	if(!dirMtrRight){
-		trisMtrRightDirClr	= ( 1 << bnMtrRightDir );	
-		prtMtrRightDirSet	= ( 1 << bnMtrRightDir );	// forward
-	}else if(dirMtrRight){
-		trisMtrRightDirClr	= ( 1 << bnMtrRightDir );	
-		prtMtrRightDirClr	= ( 1 << bnMtrRightDir );	// backward
-	}		
-
-	OC3R 	= dtcMtrLeft;   
-	OC3RS	= dtcMtrLeft;
-	OC2R	= dtcMtrRight;
-	OC2RS	= dtcMtrRight;
+
+	PwmSet(&pwmLeft, ( dirMtrLeft == dirMtrLeftFwd ) ?
+					 (int32_t)dtcMtrLeft : -(int32_t)dtcMtrLeft);
+	PwmSet(&pwmRight, ( dirMtrRight == dirMtrRightFwd ) ?
+					  (int32_t)dtcMtrRight : -(int32_t)dtcMtrRight);
 }
 
 
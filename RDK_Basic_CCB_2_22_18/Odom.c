@@ -0,0 +1,126 @@
+/************************************************************************/
+/*																		*/
+/*	Odom.c	--  Differential Drive Odometry                             */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the pose integrator. Each      */
+/*  update is two table lookups, two 32x32 multiplies into 64-bit sums  */
+/*  and a handful of adds; there is no float arithmetic.                */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Odom.h"
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+struct odom	odom;
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	OdomReset
+**
+**	Synopsis:
+**		OdomReset(cTickLeft, cTickRight)
+**
+**	Parameters:
+**		cTickLeft  - current left wheel count
+**		cTickRight - current right wheel count
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Puts the robot at (0, 0) with heading 0 and takes the given
+**		counts as the starting point for the next update.
+*/
+
+void OdomReset(int32_t cTickLeft, int32_t cTickRight)
+{
+	odom.cTickLeft	= cTickLeft;
+	odom.cTickRight	= cTickRight;
+	odom.cTickSum	= 0;
+	odom.xQ32		= 0;
+	odom.yQ32		= 0;
+	odom.x			= 0;
+	odom.y			= 0;
+	odom.ang		= 0;
+	odom.s			= 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	OdomUpdate
+**
+**	Synopsis:
+**		OdomUpdate(cTickLeft, cTickRight)
+**
+**	Parameters:
+**		cTickLeft  - current left wheel count
+**		cTickRight - current right wheel count
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Advances the pose by the wheel motion since the last call. The
+**		robot center moves (dL + dR) / 2 along the heading halfway
+**		through the turn (dR - dL) / track. For an arc this is
+**		accurate to second order in the turn angle per update.
+**
+**		Must be called from only one context (the control tick).
+*/
+
+void OdomUpdate(int32_t cTickLeft, int32_t cTickRight)
+{
+	int32_t	dtickL = cTickLeft - odom.cTickLeft;
+	int32_t	dtickR = cTickRight - odom.cTickRight;
+	int32_t	ftQ24;		// center travel this tick, Q24 feet
+	WORD	dang;
+	WORD	angMid;
+
+	odom.cTickLeft = cTickLeft;
+	odom.cTickRight = cTickRight;
+
+	if ( ( dtickL == 0 ) && ( dtickR == 0 ) ) {
+		return;
+	}
+
+	dang = (WORD)( dtickR - dtickL ) * angOdomTick;
+	angMid = odom.ang + ( (WORD)( (int32_t)dang >> 1 ) );
+	odom.ang += dang;
+
+	// (dL + dR) / 2 ticks in Q24 feet; Q24 * Q15 >> 7 is Q32
+	ftQ24 = ( ( dtickL + dtickR ) * ftOdomTickQ24 ) >> 1;
+	odom.xQ32 += ( (int64_t)ftQ24 * CosQ15(angMid) ) >> 7;
+	odom.yQ32 += ( (int64_t)ftQ24 * SinQ15(angMid) ) >> 7;
+
+	odom.x = (Q16)( odom.xQ32 >> 16 );
+	odom.y = (Q16)( odom.yQ32 >> 16 );
+
+	odom.cTickSum += dtickL + dtickR;
+	odom.s = OdomFtQ16(odom.cTickSum) >> 1;
+}
+
+/************************************************************************/
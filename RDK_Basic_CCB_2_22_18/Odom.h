@@ -0,0 +1,97 @@
+/************************************************************************/
+/*																		*/
+/*	Odom.h	--  Differential Drive Odometry                             */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for dead reckoning the robot      */
+/*  pose (x, y, heading) from the signed wheel tick counts. It is       */
+/*  updated once per control tick from the change in each count since   */
+/*  the previous tick, in fixed point with table sine and cosine.       */
+/*																		*/
+/*  The pose starts at (0, 0) facing along +x. Heading is a binary      */
+/*  angle, counterclockwise positive (see fixmath.h).                   */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_ODOM_INC)
+#define _ODOM_INC
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Robot geometry. ftOdomTrack is the distance between the wheel
+**	contact points; measure it on the robot, or adjust it until a
+**	commanded full turn in place reads 360 degrees.
+*/
+#define	cOdomTickRev	160			// encoder ticks per wheel revolution
+#define	ftOdomWheelC	0.71886		// wheel circumference, feet
+#define	ftOdomTrack		0.5625		// track width, feet
+
+/*	Wheel travel per tick in Q24 feet, and heading change per tick of
+**	difference between the wheels as a binary angle. Both are compile
+**	time constants.
+*/
+#define	ftOdomTickQ24	((int32_t)( ftOdomWheelC / cOdomTickRev * 16777216.0 + 0.5 ))
+#define	angOdomTick		((WORD)( ftOdomWheelC / ( cOdomTickRev * ftOdomTrack ) * \
+									( 4294967296.0 / 6.283185307179586 ) + 0.5 ))
+
+/*	Pose and integrator state. Position is integrated in 2^-32 feet so
+**	that rounding does not build up over long runs; x and y are the same
+**	position in Q16 feet. Updated by the control tick: read it with
+**	interrupts off to get a consistent pose.
+*/
+struct odom {
+	int32_t		cTickLeft;	// wheel counts at the last update
+	int32_t		cTickRight;
+	int32_t		cTickSum;	// left plus right ticks since reset
+	int64_t		xQ32;
+	int64_t		yQ32;
+	Q16			x;			// feet
+	Q16			y;			// feet
+	WORD		ang;		// heading
+	Q16			s;			// distance travelled by the robot center, feet
+};
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	struct odom	odom;
+
+/* ------------------------------------------------------------ */
+/*					        Macros		        				*/
+/* ------------------------------------------------------------ */
+
+/***	OdomFtQ16
+**
+**	Converts a wheel tick count into Q16 feet.
+*/
+static inline Q16 OdomFtQ16(int32_t cTick)
+{
+	return (Q16)( ( (int64_t)cTick * ftOdomTickQ24 ) >> 8 );
+}
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+void	OdomReset(int32_t cTickLeft, int32_t cTickRight);
+void	OdomUpdate(int32_t cTickLeft, int32_t cTickRight);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
@@ -0,0 +1,494 @@
+/************************************************************************/
+/*																		*/
+/*	Pid.c	--  Fixed Point PID Controller                              */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the PID controller. Each       */
+/*  instance holds its own gains, limits and state, so one instance     */
+/*  can run per wheel.                                                  */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Pid.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	tusPerSec		1000000
+
+/*	Gain products and ratios, saturated at kPidMax.
+*/
+#define	KMulSat(k, scale)	Q16Clamp(((int64_t)(k) * (scale)) >> bnQ16Frac, -kPidMax, kPidMax)
+#define	KDivSat(k, kRef)	Q16Clamp(((int64_t)(k) << bnQ16Frac) / (kRef), -kPidMax, kPidMax)
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	void	PidApplyGains(struct pid * ppid, Q16 kp, Q16 ki, Q16 kd);
+static	void	PidSchedApply(struct pid * ppid);
+static	void	PidSchedLookup(const struct pidsched * psched, Q16 x, Q16 * pkp, Q16 * pki, Q16 * pkd);
+static	Q16		Q16Clamp(int64_t q, Q16 qMin, Q16 qMax);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	PidInit
+**
+**	Synopsis:
+**		PidInit(ppid, tusTick, outMin, outMax, aw)
+**
+**	Parameters:
+**		ppid    - controller to initialize
+**		tusTick - period between calls to PidUpdate, microseconds
+**		outMin  - lowest output
+**		outMax  - highest output
+**		aw      - anti-windup mode, awPidXxx
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Sets the limits and clears the gains and state. Call
+**		PidSetGains before the first update.
+*/
+
+void PidInit(struct pid * ppid, WORD tusTick, Q16 outMin, Q16 outMax, BYTE aw)
+{
+	ppid->kp		= 0;
+	ppid->kiTick	= 0;
+	ppid->kdTick	= 0;
+	ppid->kawTick	= kawPidDefault;
+	ppid->tusTick	= tusTick;
+	ppid->outMin	= outMin;
+	ppid->outMax	= outMax;
+	ppid->aw		= aw;
+	ppid->psched	= NULL;
+	ppid->xSched	= 0;
+	ppid->kpScale	= q16One;
+	ppid->kiScale	= q16One;
+	ppid->kdScale	= q16One;
+
+	PidReset(ppid);
+}
+
+/* ------------------------------------------------------------ */
+/***	PidSetGains
+**
+**	Synopsis:
+**		PidSetGains(ppid, kp, ki, kd)
+**
+**	Parameters:
+**		ppid - controller
+**		kp   - output units per unit of error
+**		ki   - output units per unit of error per second
+**		kd   - output units per unit of error per unit/second
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Sets the gains at the present operating point. Without a
+**		schedule they are used as given; with one, the schedule is
+**		scaled to pass through them there (an entry with a zero gain
+**		is left unscaled), and an entry scaled past kPidMax is held
+**		at it. May be called between updates without bumping the
+**		output.
+*/
+
+void PidSetGains(struct pid * ppid, Q16 kp, Q16 ki, Q16 kd)
+{
+	Q16		kpSched;
+	Q16		kiSched;
+	Q16		kdSched;
+
+	if ( ppid->psched == NULL ) {
+		PidApplyGains(ppid, kp, ki, kd);
+		return;
+	}
+
+	PidSchedLookup(ppid->psched, ppid->xSched, &kpSched, &kiSched, &kdSched);
+	ppid->kpScale = ( kpSched != 0 ) ? KDivSat(kp, kpSched) : q16One;
+	ppid->kiScale = ( kiSched != 0 ) ? KDivSat(ki, kiSched) : q16One;
+	ppid->kdScale = ( kdSched != 0 ) ? KDivSat(kd, kdSched) : q16One;
+	PidSchedApply(ppid);
+}
+
+/* ------------------------------------------------------------ */
+/***	PidSetSchedule
+**
+**	Synopsis:
+**		PidSetSchedule(ppid, psched, x)
+**
+**	Parameters:
+**		ppid   - controller
+**		psched - gain schedule, or NULL to keep the present gains fixed
+**		x      - present operating point
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Attaches a schedule with unit scale and takes the gains from
+**		it at x.
+*/
+
+void PidSetSchedule(struct pid * ppid, const struct pidsched * psched, Q16 x)
+{
+	ppid->psched	= psched;
+	ppid->xSched	= x;
+	ppid->kpScale	= q16One;
+	ppid->kiScale	= q16One;
+	ppid->kdScale	= q16One;
+
+	if ( psched != NULL ) {
+		PidSchedApply(ppid);
+	}
+}
+
+/* ------------------------------------------------------------ */
+/***	PidSchedule
+**
+**	Synopsis:
+**		PidSchedule(ppid, x)
+**
+**	Parameters:
+**		ppid - controller
+**		x    - operating point
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Moves a scheduled controller to operating point x, ahead of
+**		PidUpdate. Does nothing if x has not changed, or if there
+**		is no schedule.
+*/
+
+void PidSchedule(struct pid * ppid, Q16 x)
+{
+	if ( ( ppid->psched == NULL ) || ( x == ppid->xSched ) ) {
+		return;
+	}
+
+	ppid->xSched = x;
+	PidSchedApply(ppid);
+}
+
+/* ------------------------------------------------------------ */
+/***	PidSetLimits
+**
+**	Synopsis:
+**		PidSetLimits(ppid, outMin, outMax)
+**
+**	Parameters:
+**		ppid   - controller
+**		outMin - output limits
+**		outMax
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Changes the output limits. May be called before every update;
+**		the next update brings the integral within the new bounds.
+*/
+
+void PidSetLimits(struct pid * ppid, Q16 outMin, Q16 outMax)
+{
+	ppid->outMin = outMin;
+	ppid->outMax = outMax;
+}
+
+/* ------------------------------------------------------------ */
+/***	PidReset
+**
+**	Synopsis:
+**		PidReset(ppid)
+**
+**	Parameters:
+**		ppid - controller
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Clears the integral and the derivative history.
+*/
+
+void PidReset(struct pid * ppid)
+{
+	ppid->errPrev	= 0;
+	ppid->p			= 0;
+	ppid->i			= 0;
+	ppid->d			= 0;
+	ppid->ff		= 0;
+	ppid->out		= 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	PidUpdate
+**
+**	Synopsis:
+**		out = PidUpdate(ppid, err, ff)
+**
+**	Parameters:
+**		ppid - controller
+**		err  - setpoint minus measurement
+**		ff   - feedforward, output units; 0 for none
+**
+**	Return Values:
+**		new output, between outMin and outMax
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Runs one controller tick. The integral is limited to the
+**		output range less the feedforward in every mode.
+*/
+
+Q16 PidUpdate(struct pid * ppid, Q16 err, Q16 ff)
+{
+	int64_t	outRaw;
+	Q16		out;
+	Q16		i;
+	Q16		iMin;
+	Q16		iMax;
+	Q16		outAbs;
+
+	ff = Q16Clamp(ff, ppid->outMin, ppid->outMax);
+	iMin = ppid->outMin - ff;
+	iMax = ppid->outMax - ff;
+
+	// P and D are bounded by the limit furthest from zero, either side.
+	outAbs = ( -ppid->outMin > ppid->outMax ) ? -ppid->outMin : ppid->outMax;
+
+	ppid->p = Q16Clamp(((int64_t)ppid->kp * err) >> bnQ16Frac, -outAbs, outAbs);
+	ppid->d = Q16Clamp(((int64_t)ppid->kdTick * (err - ppid->errPrev)) >> bnQ16Frac,
+					   -outAbs, outAbs);
+	ppid->errPrev = err;
+
+	i = Q16Clamp((int64_t)ppid->i + Q16Mul(ppid->kiTick, err), iMin, iMax);
+
+	outRaw = (int64_t)ppid->p + i + ppid->d + ff;
+	out = Q16Clamp(outRaw, ppid->outMin, ppid->outMax);
+
+	switch ( ppid->aw ) {
+		case awPidClamp:
+			// Keep the old integral if it would push further into the limit.
+			if ( ( ( outRaw > ppid->outMax ) && ( err > 0 ) ) ||
+				 ( ( outRaw < ppid->outMin ) && ( err < 0 ) ) ) {
+				i = ppid->i;
+			}
+			break;
+
+		case awPidBack:
+			i = Q16Clamp((int64_t)i + ( ( (int64_t)ppid->kawTick * ( out - outRaw ) ) >> bnQ16Frac ),
+						 iMin, iMax);
+			break;
+
+		default:
+			break;
+	}
+
+	ppid->i = i;
+	ppid->ff = ff;
+	ppid->out = out;
+
+	return out;
+}
+
+/* ------------------------------------------------------------ */
+/***	PidApplyGains
+**
+**	Synopsis:
+**		PidApplyGains(ppid, kp, ki, kd)
+**
+**	Parameters:
+**		ppid - controller
+**		kp   - output units per unit of error
+**		ki   - output units per unit of error per second
+**		kd   - output units per unit of error per unit/second
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Computes the per-tick coefficients. The integral is kept in
+**		output units, so a change in ki does not move the output; a
+**		change in kp would, by the change times the last error, and
+**		the integral takes that up.
+*/
+
+static void PidApplyGains(struct pid * ppid, Q16 kp, Q16 ki, Q16 kd)
+{
+	ppid->i = Q16Clamp((int64_t)ppid->i +
+					   ( ( (int64_t)( ppid->kp - kp ) * ppid->errPrev ) >> bnQ16Frac ),
+					   ppid->outMin - ppid->ff, ppid->outMax - ppid->ff);
+
+	ppid->kp = kp;
+	ppid->kiTick = Q16Clamp(( (int64_t)ki * ppid->tusTick ) / tusPerSec, -kPidMax, kPidMax);
+	ppid->kdTick = Q16Clamp(( (int64_t)kd * tusPerSec ) / ppid->tusTick, -kPidMax, kPidMax);
+}
+
+/* ------------------------------------------------------------ */
+/***	PidSchedApply
+**
+**	Synopsis:
+**		PidSchedApply(ppid)
+**
+**	Parameters:
+**		ppid - controller with a schedule
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Sets the scaled schedule gains at xSched. A scaled gain past
+**		kPidMax saturates there, so it never wraps to the wrong sign.
+*/
+
+static void PidSchedApply(struct pid * ppid)
+{
+	Q16		kp;
+	Q16		ki;
+	Q16		kd;
+
+	PidSchedLookup(ppid->psched, ppid->xSched, &kp, &ki, &kd);
+	PidApplyGains(ppid, KMulSat(kp, ppid->kpScale), KMulSat(ki, ppid->kiScale),
+				  KMulSat(kd, ppid->kdScale));
+}
+
+/* ------------------------------------------------------------ */
+/***	PidSchedLookup
+**
+**	Synopsis:
+**		PidSchedLookup(psched, x, pkp, pki, pkd)
+**
+**	Parameters:
+**		psched - gain schedule
+**		x      - operating point
+**		pkp    - receives kp
+**		pki    - receives ki
+**		pkd    - receives kd
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Interpolates the unscaled schedule at x, holding the first
+**		and last entries beyond the ends.
+*/
+
+static void PidSchedLookup(const struct pidsched * psched, Q16 x, Q16 * pkp, Q16 * pki, Q16 * pkd)
+{
+	const struct pidgain *	pgain0;
+	const struct pidgain *	pgain1;
+	WORD					igain;
+	Q16						frac;
+
+	if ( x <= psched->rggain[0].x ) {
+		pgain0 = &psched->rggain[0];
+		*pkp = pgain0->kp;
+		*pki = pgain0->ki;
+		*pkd = pgain0->kd;
+		return;
+	}
+
+	for ( igain = 1; igain < psched->cGain; igain++ ) {
+		if ( x < psched->rggain[igain].x ) {
+			break;
+		}
+	}
+	if ( igain >= psched->cGain ) {
+		pgain0 = &psched->rggain[psched->cGain - 1];
+		*pkp = pgain0->kp;
+		*pki = pgain0->ki;
+		*pkd = pgain0->kd;
+		return;
+	}
+
+	pgain0 = &psched->rggain[igain - 1];
+	pgain1 = &psched->rggain[igain];
+	frac = Q16Div(x - pgain0->x, pgain1->x - pgain0->x);
+	*pkp = pgain0->kp + Q16Mul(pgain1->kp - pgain0->kp, frac);
+	*pki = pgain0->ki + Q16Mul(pgain1->ki - pgain0->ki, frac);
+	*pkd = pgain0->kd + Q16Mul(pgain1->kd - pgain0->kd, frac);
+}
+
+/* ------------------------------------------------------------ */
+/***	Q16Clamp
+**
+**	Synopsis:
+**		q = Q16Clamp(q, qMin, qMax)
+**
+**	Parameters:
+**		q    - value to limit, with 64-bit headroom
+**		qMin - lower limit
+**		qMax - upper limit
+**
+**	Return Values:
+**		q limited to [qMin, qMax]
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Saturates an intermediate sum back into a Q16.
+*/
+
+static Q16 Q16Clamp(int64_t q, Q16 qMin, Q16 qMax)
+{
+	if ( q > qMax ) {
+		return qMax;
+	}
+	if ( q < qMin ) {
+		return qMin;
+	}
+	return (Q16)q;
+}
+
+/************************************************************************/
@@ -0,0 +1,120 @@
+/************************************************************************/
+/*																		*/
+/*	Pid.h	--  Fixed Point PID Controller                              */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for a Q16.16 PID controller with  */
+/*  output saturation and anti-windup. Gains are given in per-second    */
+/*  units and turned into per-tick coefficients once, when they are     */
+/*  set, so an update is three multiplies and no divides.               */
+/*																		*/
+/*  The integral is kept in output units, not as a sum of errors, so    */
+/*  changing the gains does not bump the output.                        */
+/*																		*/
+/*  A feedforward term can be passed with each update. It is added      */
+/*  before saturation, and the integral is bounded to what is left of   */
+/*  the output range after it, so the integral only carries the         */
+/*  correction the feedforward does not supply.                         */
+/*																		*/
+/*  The gains can follow a schedule: a table of gain sets keyed by an   */
+/*  operating point (the commanded speed for the wheels), interpolated  */
+/*  linearly and held at the ends. Gain changes are bumpless: the       */
+/*  integral absorbs the step in the proportional term, so the output   */
+/*  does not jump when the operating point moves between entries.       */
+/*  PidSetGains on a scheduled controller scales the whole table so     */
+/*  that it passes through the given gains at the present operating     */
+/*  point.                                                              */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_PID_INC)
+#define _PID_INC
+
+#include <stddef.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Anti-windup modes. With clamping the integral stops while the
+**	output is saturated and the error would drive it further. With back
+**	calculation the integral is pulled toward the value that would just
+**	bring the output out of saturation, at kawTick of the excess per
+**	tick.
+*/
+#define	awPidNone		0
+#define	awPidClamp		1
+#define	awPidBack		2
+
+#define	kawPidDefault	Q16FromFloat(0.5)
+
+/*	Gain ceiling. A schedule scaled up by PidSetGains, and the per-tick
+**	coefficients worked out from the gains, saturate at kPidMax either
+**	side rather than wrap: an entry that would exceed it runs at it.
+*/
+#define	kPidMax			((Q16)0x7FFFFFFF)
+
+/*	One entry of a gain schedule, in the units of PidSetGains. The
+**	entries of a schedule are in increasing x.
+*/
+struct pidgain {
+	Q16		x;			// operating point
+	Q16		kp;
+	Q16		ki;
+	Q16		kd;
+};
+
+struct pidsched {
+	WORD					cGain;
+	const struct pidgain *	rggain;
+};
+
+struct pid {
+	Q16		kp;			// proportional gain
+	Q16		kiTick;		// integral gain times the tick period
+	Q16		kdTick;		// derivative gain over the tick period
+	Q16		kawTick;	// back calculation gain per tick
+	WORD	tusTick;	// tick period, microseconds
+	Q16		outMin;		// output limits; also bound the integral
+	Q16		outMax;
+	BYTE	aw;			// anti-windup mode
+	const struct pidsched *	psched;	// gain schedule, or NULL
+	Q16		xSched;		// operating point of the present gains
+	Q16		kpScale;	// schedule scale factors
+	Q16		kiScale;
+	Q16		kdScale;
+	Q16		errPrev;	// error at the previous update
+	Q16		p;			// terms of the last update, output units
+	Q16		i;
+	Q16		d;
+	Q16		ff;			// feedforward of the last update
+	Q16		out;		// last saturated output
+};
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+void	PidInit(struct pid * ppid, WORD tusTick, Q16 outMin, Q16 outMax, BYTE aw);
+void	PidSetGains(struct pid * ppid, Q16 kp, Q16 ki, Q16 kd);
+void	PidSetSchedule(struct pid * ppid, const struct pidsched * psched, Q16 x);
+void	PidSchedule(struct pid * ppid, Q16 x);
+void	PidSetLimits(struct pid * ppid, Q16 outMin, Q16 outMax);
+void	PidReset(struct pid * ppid);
+Q16		PidUpdate(struct pid * ppid, Q16 err, Q16 ff);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
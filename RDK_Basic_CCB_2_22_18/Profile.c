@@ -0,0 +1,238 @@
+/************************************************************************/
+/*																		*/
+/*	Profile.c	--  Velocity Profile Generator                          */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the trapezoidal and S-curve    */
+/*  speed profiles.                                                     */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Profile.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	tusPerSec		1000000
+
+#define	ProfAbs(q)		( ( (q) < 0 ) ? -(q) : (q) )
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	BOOL	FProfFits(int64_t dspd, int64_t acc, int64_t jerk, int64_t sgn);
+static	int64_t	ProfClamp(int64_t q, int64_t qMax);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	ProfInit
+**
+**	Synopsis:
+**		ProfInit(pprof, accMax, jerkMax, tusTick)
+**
+**	Parameters:
+**		pprof   - profile to initialize
+**		accMax  - acceleration limit, ft/s^2
+**		jerkMax - jerk limit, ft/s^3; 0 for a trapezoidal profile
+**		tusTick - period between calls to ProfTick, microseconds
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Sets the limits and starts the profile at rest.
+*/
+
+void ProfInit(struct prof * pprof, Q16 accMax, Q16 jerkMax, WORD tusTick)
+{
+	pprof->accMaxQ24 = ( ( (int64_t)accMax << ( bnProfFrac - bnQ16Frac ) ) * tusTick ) /
+					   tusPerSec;
+	pprof->jerkMaxQ24 = ( ( ( (int64_t)jerkMax << ( bnProfFrac - bnQ16Frac ) ) * tusTick ) /
+						  tusPerSec * tusTick ) / tusPerSec;
+
+	// A jerk too small to represent would stall the profile.
+	if ( ( jerkMax != 0 ) && ( pprof->jerkMaxQ24 == 0 ) ) {
+		pprof->jerkMaxQ24 = 1;
+	}
+
+	ProfReset(pprof, 0);
+}
+
+/* ------------------------------------------------------------ */
+/***	ProfReset
+**
+**	Synopsis:
+**		ProfReset(pprof, spd)
+**
+**	Parameters:
+**		pprof - profile
+**		spd   - speed to restart from, ft/s
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Moves the output to spd with zero acceleration.
+*/
+
+void ProfReset(struct prof * pprof, Q16 spd)
+{
+	pprof->spdQ24	= (int64_t)spd << ( bnProfFrac - bnQ16Frac );
+	pprof->accQ24	= 0;
+	pprof->spd		= spd;
+}
+
+/* ------------------------------------------------------------ */
+/***	ProfTick
+**
+**	Synopsis:
+**		spd = ProfTick(pprof, spdTarget)
+**
+**	Parameters:
+**		pprof     - profile
+**		spdTarget - speed to move toward, ft/s
+**
+**	Return Values:
+**		shaped speed for this tick, ft/s
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Advances the profile one tick. For the S-curve, ramping an
+**		acceleration a down to zero at j per tick changes the speed
+**		by a |a| / 2j + a / 2. Each tick the acceleration builds
+**		by j toward accMax if that still leaves room to ramp it out
+**		before the target, holds if holding does, and otherwise
+**		ramps down, so the output arrives at the target with no
+**		acceleration left. The test is multiplied through by 2j to
+**		avoid the divide. Once within one step, or if a step would
+**		pass the target, the output lands on the target exactly, so
+**		it never overshoots.
+*/
+
+Q16 ProfTick(struct prof * pprof, Q16 spdTarget)
+{
+	int64_t	spdTargetQ24 = (int64_t)spdTarget << ( bnProfFrac - bnQ16Frac );
+	int64_t	dspd = spdTargetQ24 - pprof->spdQ24;
+	int64_t	acc = pprof->accQ24;
+	int64_t	jerk = pprof->jerkMaxQ24;
+	int64_t	accUp;
+	int64_t	sgn;
+
+	if ( ( dspd == 0 ) && ( acc == 0 ) ) {
+		return pprof->spd;
+	}
+
+	if ( jerk == 0 ) {
+		// Trapezoid: step straight at the acceleration limit.
+		acc = ProfClamp(dspd, pprof->accMaxQ24);
+	}
+	else if ( ( ProfAbs(dspd) <= jerk ) && ( ProfAbs(acc) <= jerk ) ) {
+		pprof->spdQ24 = spdTargetQ24;
+		acc = 0;
+	}
+	else {
+		sgn = ( dspd >= 0 ) ? 1 : -1;
+		accUp = ProfClamp(acc + sgn * jerk, pprof->accMaxQ24);
+
+		if ( FProfFits(dspd, accUp, jerk, sgn) ) {
+			acc = accUp;
+		}
+		else if ( !FProfFits(dspd, acc, jerk, sgn) ) {
+			acc -= sgn * jerk;
+		}
+	}
+
+	pprof->spdQ24 += acc;
+
+	// The ramp-out test holds for continuous time; with whole ticks
+	// the last steps can still carry past the target, so land on it.
+	if ( ( ( dspd > 0 ) && ( pprof->spdQ24 > spdTargetQ24 ) ) ||
+		 ( ( dspd < 0 ) && ( pprof->spdQ24 < spdTargetQ24 ) ) ) {
+		pprof->spdQ24 = spdTargetQ24;
+		acc = 0;
+	}
+	pprof->accQ24 = acc;
+
+	pprof->spd = (Q16)( pprof->spdQ24 >> ( bnProfFrac - bnQ16Frac ) );
+	return pprof->spd;
+}
+
+/* ------------------------------------------------------------ */
+/***	FProfFits
+**
+**	Synopsis:
+**		f = FProfFits(dspd, acc, jerk, sgn)
+**
+**	Parameters:
+**		dspd - speed still to go, Q24
+**		acc  - acceleration to test, Q24 per tick
+**		jerk - jerk limit, Q24 per tick per tick
+**		sgn  - sign of dspd
+**
+**	Return Values:
+**		fTrue if taking a step at acc and then ramping it out at
+**		jerk stays within dspd
+**
+**	Errors:
+**		none
+*/
+
+static BOOL FProfFits(int64_t dspd, int64_t acc, int64_t jerk, int64_t sgn)
+{
+	return sgn * ( ( 2 * dspd - acc ) * jerk - acc * ProfAbs(acc) ) >= 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	ProfClamp
+**
+**	Synopsis:
+**		q = ProfClamp(q, qMax)
+**
+**	Parameters:
+**		q    - value to limit
+**		qMax - magnitude limit
+**
+**	Return Values:
+**		q limited to [-qMax, qMax]
+**
+**	Errors:
+**		none
+*/
+
+static int64_t ProfClamp(int64_t q, int64_t qMax)
+{
+	if ( q > qMax ) {
+		return qMax;
+	}
+	if ( q < -qMax ) {
+		return -qMax;
+	}
+	return q;
+}
+
+/************************************************************************/
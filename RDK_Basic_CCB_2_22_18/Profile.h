@@ -0,0 +1,63 @@
+/************************************************************************/
+/*																		*/
+/*	Profile.h	--  Velocity Profile Generator                          */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for shaping a speed setpoint.     */
+/*  Called once per control tick with the target speed, a profile       */
+/*  moves its output toward the target with the acceleration limited    */
+/*  to accMax and, for an S-curve, the change in acceleration limited   */
+/*  to jerkMax. With jerkMax = 0 the profile is trapezoidal. The        */
+/*  target may change at any time, including mid ramp.                  */
+/*																		*/
+/*  The limits are turned into per-tick steps once, by ProfInit, so a   */
+/*  tick is a few 64-bit adds and multiplies and no divides. The state  */
+/*  is kept in Q24 so that small per-tick steps at high tick rates are  */
+/*  not lost to rounding.                                               */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_PROFILE_INC)
+#define _PROFILE_INC
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+#define	bnProfFrac		24
+
+/*	Profile state. spd is the shaped speed; spdQ24 and accQ24 carry the
+**	extra precision. The limits are per tick.
+*/
+struct prof {
+	int64_t	accMaxQ24;		// ft/s per tick
+	int64_t	jerkMaxQ24;		// ft/s per tick per tick; 0 for trapezoid
+	int64_t	spdQ24;			// ft/s
+	int64_t	accQ24;			// ft/s per tick
+	Q16		spd;			// ft/s
+};
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+void	ProfInit(struct prof * pprof, Q16 accMax, Q16 jerkMax, WORD tusTick);
+void	ProfReset(struct prof * pprof, Q16 spd);
+Q16		ProfTick(struct prof * pprof, Q16 spdTarget);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
@@ -0,0 +1,437 @@
+/************************************************************************/
+/*																		*/
+/*	Pwm.c	--  Motor PWM Output                                        */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the motor enable PWM outputs   */
+/*  and the direction pins.                                             */
+/*																		*/
+/*  Without OPT_TB32 OCxRS is loaded into OCxR at the Timer 2 period    */
+/*  match. A reversal writes 0 to OCxRS and enables the Timer 2         */
+/*  interrupt; at the next match the period with the enable low has     */
+/*  begun, so the interrupt switches the pin and writes the new duty,   */
+/*  which starts one period later.                                      */
+/*																		*/
+/*  With OPT_TB32 each period is one dual compare single pulse: OCxR    */
+/*  is the rising edge and OCxRS the falling edge, both absolute times  */
+/*  on the 32-bit timebase. The OC interrupt at the falling edge moves  */
+/*  both forward one period and re-arms the module through OCM = 000,   */
+/*  since a single pulse module only starts again on a mode change. A   */
+/*  channel set to 0 is left idle and PwmSet starts it again. A         */
+/*  reversal lets the pulse already scheduled finish, switches the pin  */
+/*  at its falling edge and leaves the next period out.                 */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <plib.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "Timebase.h"
+#include "Pwm.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+struct pwm	pwmLeft;
+struct pwm	pwmRight;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	void	PwmSetDir(struct pwm * ppwm, BOOL fFwd);
+#if OPT_TB32
+static	void	PwmArm(struct pwm * ppwm, WORD tusRise);
+static	void	PwmNext(struct pwm * ppwm);
+#else
+static	void	PwmRevStep(struct pwm * ppwm);
+#endif
+
+/* ------------------------------------------------------------ */
+/*				Interrupt Service Routines	            	    */
+/* ------------------------------------------------------------ */
+
+#if OPT_TB32
+void __ISR(_OUTPUT_COMPARE_2_VECTOR, ipl6) OC2_IntHandler(void)
+{
+	IFS0CLR = ( 1 << bnOcIf(2) );
+	PwmNext(&pwmLeft);
+}
+
+void __ISR(_OUTPUT_COMPARE_3_VECTOR, ipl6) OC3_IntHandler(void)
+{
+	IFS0CLR = ( 1 << bnOcIf(3) );
+	PwmNext(&pwmRight);
+}
+#else
+void __ISR(_TIMER_2_VECTOR, ipl6) Timer2Handler(void)
+{
+	IFS0CLR = ( 1 << bnT2If );
+	PwmRevStep(&pwmLeft);
+	PwmRevStep(&pwmRight);
+	IEC0CLR = ( 1 << bnT2If );
+}
+#endif
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	PwmInit
+**
+**	Synopsis:
+**		PwmInit()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Configures OC2 and OC3 with the outputs low and both motors
+**		set forward. Without OPT_TB32 this also sets up and starts
+**		Timer 2 as the PWM timer, with its interrupt at level 6, sub 3
+**		for reversals. With OPT_TB32 the timebase must already be
+**		running (TbInit), and the OC interrupts are enabled at level
+**		6, sub 3.
+*/
+
+void PwmInit(void)
+{
+	pwmLeft.pocCon	= &OC2CON;
+	pwmLeft.pocR	= &OC2R;
+	pwmLeft.pocRs	= &OC2RS;
+	pwmLeft.tusHigh	= 0;
+
+	pwmRight.pocCon	= &OC3CON;
+	pwmRight.pocR	= &OC3R;
+	pwmRight.pocRs	= &OC3RS;
+	pwmRight.tusHigh = 0;
+
+	// The left motor is forward with its pin low, the right with it high.
+	pwmLeft.pprtDirSet	= &prtMtrLeftDirSet;
+	pwmLeft.pprtDirClr	= &prtMtrLeftDirClr;
+	pwmLeft.fbDir		= ( 1 << bnMtrLeftDir );
+	pwmLeft.fFwdHigh	= fFalse;
+	pwmLeft.fRev		= fFalse;
+
+	pwmRight.pprtDirSet	= &prtMtrRightDirSet;
+	pwmRight.pprtDirClr	= &prtMtrRightDirClr;
+	pwmRight.fbDir		= ( 1 << bnMtrRightDir );
+	pwmRight.fFwdHigh	= fTrue;
+	pwmRight.fRev		= fFalse;
+
+	trisMtrLeftDirClr	= ( 1 << bnMtrLeftDir );
+	trisMtrRightDirClr	= ( 1 << bnMtrRightDir );
+	PwmSetDir(&pwmLeft, fTrue);
+	PwmSetDir(&pwmRight, fTrue);
+
+#if OPT_TB32
+	pwmLeft.fIdle	= fTrue;
+	pwmRight.fIdle	= fTrue;
+
+	OC2CON	= ( 1 << bnOc32 );
+	OC3CON	= ( 1 << bnOc32 );
+
+	IPC2SET	= ( ( iplPwm << 2 ) | ipsPwm ) << 16;
+	IPC3SET	= ( ( iplPwm << 2 ) | ipsPwm ) << 16;
+	IFS0CLR	= ( 1 << bnOcIf(2) ) | ( 1 << bnOcIf(3) );
+	IEC0SET	= ( 1 << bnOcIf(2) ) | ( 1 << bnOcIf(3) );
+
+	// Module on with OCM = 000; PwmSet starts the first pulse.
+	OC2CONSET	= ( 1 << bnOcOn );
+	OC3CONSET	= ( 1 << bnOcOn );
+#else
+	OC2CON	= ocmPwm;	// pwm using T2
+	OC2R	= 0;
+	OC2RS	= 0;
+
+	OC3CON	= ocmPwm;	// pwm using T2
+	OC3R	= 0;
+	OC3RS	= 0;
+
+	T2CON	= 0;
+	TMR2	= 0;
+	PR2		= tusPwmPeriod - 1;
+
+	// Bit 15 is the enable; setting TCKPS = [011] results in prescaler of 8
+	// The period match interrupt is enabled only during a reversal.
+	IPC2SET		= ( iplPwm << 2 ) | ipsPwm;
+	IFS0CLR		= ( 1 << bnT2If );
+
+	T2CON		= ( 1 << 15 ) | ( 1 << 5 ) | ( 1 << 4 );
+	OC2CONSET	= ( 1 << bnOcOn );
+	OC3CONSET	= ( 1 << bnOcOn );
+#endif
+}
+
+/* ------------------------------------------------------------ */
+/***	PwmSet
+**
+**	Synopsis:
+**		PwmSet(ppwm, dtc)
+**
+**	Parameters:
+**		ppwm - output to change
+**		dtc  - high time per period in microseconds, negative to
+**			   drive the motor backward
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Sets the duty cycle, limited to dtcPwmMax. The new value takes
+**		effect at the start of the next period. A duty against the
+**		present direction starts a reversal, and takes effect once
+**		the output has been low for a period; until then further
+**		calls only change what it ends with. Zero leaves the direction
+**		as it is. With OPT_TB32 an idle channel is started with its
+**		first pulse tusPwmLead from now, or a period from now if it
+**		is reversed.
+*/
+
+void PwmSet(struct pwm * ppwm, int32_t dtc)
+{
+	unsigned int	st;
+	BOOL			fFwd = ( dtc >= 0 );
+	WORD			tus = fFwd ? dtc : -dtc;
+
+	if ( tus > dtcPwmMax ) {
+		tus = dtcPwmMax;
+	}
+
+	st = INTDisableInterrupts();
+	if ( tus == 0 ) {
+		fFwd = ppwm->fRev ? ppwm->fFwdNext : ppwm->fFwd;
+	}
+
+	if ( ppwm->fRev ) {
+		ppwm->tusNext = tus;
+		ppwm->fFwdNext = fFwd;
+	}
+#if OPT_TB32
+	else if ( fFwd != ppwm->fFwd ) {
+		if ( ppwm->fIdle ) {
+			// Already low and nothing scheduled.
+			PwmSetDir(ppwm, fFwd);
+			ppwm->tusHigh = tus;
+			ppwm->fIdle = fFalse;
+			PwmArm(ppwm, TMRTB + tusPwmPeriod);
+		}
+		else {
+			// PwmNext switches at the end of the pulse now scheduled.
+			ppwm->tusNext = tus;
+			ppwm->fFwdNext = fFwd;
+			ppwm->fRev = fTrue;
+		}
+	}
+	else {
+		ppwm->tusHigh = tus;
+		if ( ppwm->fIdle && ( tus != 0 ) ) {
+			ppwm->fIdle = fFalse;
+			PwmArm(ppwm, TMRTB + tusPwmLead);
+		}
+	}
+#else
+	else if ( fFwd != ppwm->fFwd ) {
+		// Any period match after this one loads the zero duty.
+		ppwm->tusHigh = 0;
+		*ppwm->pocRs = 0;
+		ppwm->tusNext = tus;
+		ppwm->fFwdNext = fFwd;
+		ppwm->fRev = fTrue;
+		IFS0CLR = ( 1 << bnT2If );
+		IEC0SET = ( 1 << bnT2If );
+	}
+	else {
+		ppwm->tusHigh = tus;
+		*ppwm->pocRs = tus;
+	}
+#endif
+	INTRestoreInterrupts(st);
+}
+
+/* ------------------------------------------------------------ */
+/***	PwmSetDir
+**
+**	Synopsis:
+**		PwmSetDir(ppwm, fFwd)
+**
+**	Parameters:
+**		ppwm - output whose motor to set
+**		fFwd - motor turns forward
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Sets the direction pin. Only while the output is low.
+*/
+
+static void PwmSetDir(struct pwm * ppwm, BOOL fFwd)
+{
+	if ( fFwd == ppwm->fFwdHigh ) {
+		*ppwm->pprtDirSet = ppwm->fbDir;
+	}
+	else {
+		*ppwm->pprtDirClr = ppwm->fbDir;
+	}
+	ppwm->fFwd = fFwd;
+}
+
+#if OPT_TB32
+/* ------------------------------------------------------------ */
+/***	PwmArm
+**
+**	Synopsis:
+**		PwmArm(ppwm, tusRise)
+**
+**	Parameters:
+**		ppwm    - output to arm
+**		tusRise - timebase value for the rising edge
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		After a single pulse the module holds its pin low until the
+**		mode changes; writing the same OCM = 100 back is not documented
+**		to start another one. So the mode is stepped through OCM = 000,
+**		with the pin already low, the compare values are loaded and
+**		OCM = 100 is written, which starts one more pulse. Must be
+**		called with interrupts off, so tusRise cannot fall into the
+**		past before the module is armed.
+*/
+
+static void PwmArm(struct pwm * ppwm, WORD tusRise)
+{
+	*ppwm->pocCon = ( 1 << bnOcOn ) | ( 1 << bnOc32 );
+	ppwm->tusRise = tusRise;
+	*ppwm->pocR = tusRise;
+	*ppwm->pocRs = tusRise + ppwm->tusHigh;
+	*ppwm->pocCon = ( 1 << bnOcOn ) | ( 1 << bnOc32 ) | ocmPulse;
+}
+
+/* ------------------------------------------------------------ */
+/***	PwmNext
+**
+**	Synopsis:
+**		PwmNext(ppwm)
+**
+**	Parameters:
+**		ppwm - output whose pulse just ended
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Schedules the pulse for the next period, one period after the
+**		one that just ended. If the interrupt ran so late that the
+**		next rising edge is already too close, the period is skipped
+**		and the output restarts tusPwmLead from now. A duty cycle of
+**		zero leaves the channel idle. A pending reversal switches the
+**		direction here, while the output is low, and the period after
+**		this one is left out.
+*/
+
+static void PwmNext(struct pwm * ppwm)
+{
+	unsigned int	st;
+	WORD			tusRise;
+	WORD			cPeriod;
+
+	st = INTDisableInterrupts();
+	cPeriod = 1;
+	if ( ppwm->fRev ) {
+		PwmSetDir(ppwm, ppwm->fFwdNext);
+		ppwm->tusHigh = ppwm->tusNext;
+		ppwm->fRev = fFalse;
+		cPeriod = 2;
+	}
+
+	if ( ppwm->tusHigh == 0 ) {
+		ppwm->fIdle = fTrue;
+	}
+	else {
+		tusRise = ppwm->tusRise + cPeriod * tusPwmPeriod;
+		if ( (int32_t)( tusRise - TMRTB ) < tusPwmLead ) {
+			tusRise = TMRTB + tusPwmLead;
+		}
+		PwmArm(ppwm, tusRise);
+	}
+	INTRestoreInterrupts(st);
+}
+#else
+/* ------------------------------------------------------------ */
+/***	PwmRevStep
+**
+**	Synopsis:
+**		PwmRevStep(ppwm)
+**
+**	Parameters:
+**		ppwm - output to step
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Called at the Timer 2 period match. The period that has just
+**		begun loaded the zero duty of a pending reversal, so the
+**		direction is switched now and the new duty is written to take
+**		effect at the end of it.
+*/
+
+static void PwmRevStep(struct pwm * ppwm)
+{
+	if ( !ppwm->fRev ) {
+		return;
+	}
+
+	PwmSetDir(ppwm, ppwm->fFwdNext);
+	ppwm->tusHigh = ppwm->tusNext;
+	*ppwm->pocRs = ppwm->tusNext;
+	ppwm->fRev = fFalse;
+}
+#endif
+
+/************************************************************************/
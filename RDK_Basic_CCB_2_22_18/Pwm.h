@@ -0,0 +1,111 @@
+/************************************************************************/
+/*																		*/
+/*	Pwm.h	--  Motor PWM Output                                        */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for the motor enable PWM on OC2   */
+/*  (left, RD1) and OC3 (right, RD2) and the direction pins of the      */
+/*  H-bridges (RD7, RD6). Duty cycles are signed microseconds of high   */
+/*  time per 10 ms period: positive drives the wheel forward, negative  */
+/*  backward.                                                           */
+/*																		*/
+/*  The direction pin of a bridge must not change while its enable is   */
+/*  high. A duty with the other sign is applied in three steps: the     */
+/*  enable is held low for a whole period, the pin is switched on the   */
+/*  period boundary that starts it, and the new duty drives from the    */
+/*  boundary after that. Callers just set signed duty cycles.           */
+/*																		*/
+/*  Output compare can only be timed from Timer 2 or Timer 3. Normally  */
+/*  Timer 2 is the PWM timer. With OPT_TB32 both timers form the free   */
+/*  running 32-bit capture timebase, so each OC module instead makes    */
+/*  one dual compare pulse per period on that timebase, and its         */
+/*  interrupt at the falling edge schedules the next pulse.             */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_PWM_INC)
+#define _PWM_INC
+
+#include "config.h"
+#include "stdtypes.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	PWM period in 1 us timer ticks, and the largest duty cycle. With
+**	OPT_TB32 the low time must leave the OC interrupt room to schedule
+**	the next pulse, and a new pulse is never scheduled closer than
+**	tusPwmLead to the current time.
+*/
+#define	tusPwmPeriod	10000
+#define	tusPwmLead		50
+
+#if OPT_TB32
+#define	dtcPwmMax		( tusPwmPeriod - 200 )
+#else
+#define	dtcPwmMax		( tusPwmPeriod - 1 )
+#endif
+
+/*	Output compare module bindings. The interrupt bits for OCn are bit
+**	4n+2 of IFS0 and IEC0 and bits 20:16 of IPCn.
+*/
+#define	bnOcOn			15	// OCxCON: module enable
+#define	bnOc32			5	// OCxCON: 32-bit compare
+#define	ocmPwm			6	// OCxCON<2:0>: PWM, fault pin disabled
+#define	ocmPulse		4	// OCxCON<2:0>: dual compare, single pulse
+#define	bnOcIf(n)		( ( 4 * (n) ) + 2 )
+#define	bnT2If			8	// IFS0/IEC0: Timer 2; priority in IPC2<4:0>
+
+#define	iplPwm			6
+#define	ipsPwm			3
+
+/*	Per-motor output state. While fRev is set the output is being held
+**	low for a reversal, and tusNext and fFwdNext are applied at the next
+**	period boundary.
+*/
+struct pwm {
+	volatile WORD *	pocCon;		// OCxCON of this channel
+	volatile WORD *	pocR;		// OCxR
+	volatile WORD *	pocRs;		// OCxRS
+	volatile WORD *	pprtDirSet;	// PORTxSET and PORTxCLR of the direction pin
+	volatile WORD *	pprtDirClr;
+	WORD			fbDir;		// direction pin mask
+	BOOL			fFwdHigh;	// forward with the pin high
+	volatile WORD	tusHigh;	// duty cycle for the next period
+	volatile BOOL	fFwd;		// direction the pin is set to
+	volatile BOOL	fRev;		// reversal in progress
+	volatile WORD	tusNext;	// duty and direction after it
+	volatile BOOL	fFwdNext;
+#if OPT_TB32
+	WORD			tusRise;	// start of the pulse now scheduled
+	volatile BOOL	fIdle;		// no pulse scheduled
+#endif
+};
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	struct pwm	pwmLeft;	// OC2
+extern	struct pwm	pwmRight;	// OC3
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+void	PwmInit(void);
+void	PwmSet(struct pwm * ppwm, int32_t dtc);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../main.c ../MtrCtrl.c ../spi.c ../util.c
+SOURCEFILES_QUOTED_IF_SPACED=../main.c ../MtrCtrl.c ../spi.c ../util.c ../Encoder.c ../Timebase.c ../Pwm.c ../fixmath.c ../Odom.c ../Pid.c ../Control.c ../Ffwd.c ../Tune.c ../Profile.c ../Move.c ../Fric.c ../Telem.c ../Uart.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1472/main.o ${OBJECTDIR}/_ext/1472/MtrCtrl.o ${OBJECTDIR}/_ext/1472/spi.o ${OBJECTDIR}/_ext/1472/util.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1472/main.o.d ${OBJECTDIR}/_ext/1472/MtrCtrl.o.d ${OBJECTDIR}/_ext/1472/spi.o.d ${OBJECTDIR}/_ext/1472/util.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1472/main.o ${OBJECTDIR}/_ext/1472/MtrCtrl.o ${OBJECTDIR}/_ext/1472/spi.o ${OBJECTDIR}/_ext/1472/util.o ${OBJECTDIR}/_ext/1472/Encoder.o ${OBJECTDIR}/_ext/1472/Timebase.o ${OBJECTDIR}/_ext/1472/Pwm.o ${OBJECTDIR}/_ext/1472/fixmath.o ${OBJECTDIR}/_ext/1472/Odom.o ${OBJECTDIR}/_ext/1472/Pid.o ${OBJECTDIR}/_ext/1472/Control.o ${OBJECTDIR}/_ext/1472/Ffwd.o ${OBJECTDIR}/_ext/1472/Tune.o ${OBJECTDIR}/_ext/1472/Profile.o ${OBJECTDIR}/_ext/1472/Move.o ${OBJECTDIR}/_ext/1472/Fric.o ${OBJECTDIR}/_ext/1472/Telem.o ${OBJECTDIR}/_ext/1472/Uart.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1472/main.o.d ${OBJECTDIR}/_ext/1472/MtrCtrl.o.d ${OBJECTDIR}/_ext/1472/spi.o.d ${OBJECTDIR}/_ext/1472/util.o.d ${OBJECTDIR}/_ext/1472/Encoder.o.d ${OBJECTDIR}/_ext/1472/Timebase.o.d ${OBJECTDIR}/_ext/1472/Pwm.o.d ${OBJECTDIR}/_ext/1472/fixmath.o.d ${OBJECTDIR}/_ext/1472/Odom.o.d ${OBJECTDIR}/_ext/1472/Pid.o.d ${OBJECTDIR}/_ext/1472/Control.o.d ${OBJECTDIR}/_ext/1472/Ffwd.o.d ${OBJECTDIR}/_ext/1472/Tune.o.d ${OBJECTDIR}/_ext/1472/Profile.o.d ${OBJECTDIR}/_ext/1472/Move.o.d ${OBJECTDIR}/_ext/1472/Fric.o.d ${OBJECTDIR}/_ext/1472/Telem.o.d ${OBJECTDIR}/_ext/1472/Uart.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/1472/main.o ${OBJECTDIR}/_ext/1472/MtrCtrl.o ${OBJECTDIR}/_ext/1472/spi.o ${OBJECTDIR}/_ext/1472/util.o
+OBJECTFILES=${OBJECTDIR}/_ext/1472/main.o ${OBJECTDIR}/_ext/1472/MtrCtrl.o ${OBJECTDIR}/_ext/1472/spi.o ${OBJECTDIR}/_ext/1472/util.o ${OBJECTDIR}/_ext/1472/Encoder.o ${OBJECTDIR}/_ext/1472/Timebase.o ${OBJECTDIR}/_ext/1472/Pwm.o ${OBJECTDIR}/_ext/1472/fixmath.o ${OBJECTDIR}/_ext/1472/Odom.o ${OBJECTDIR}/_ext/1472/Pid.o ${OBJECTDIR}/_ext/1472/Control.o ${OBJECTDIR}/_ext/1472/Ffwd.o ${OBJECTDIR}/_ext/1472/Tune.o ${OBJECTDIR}/_ext/1472/Profile.o ${OBJECTDIR}/_ext/1472/Move.o ${OBJECTDIR}/_ext/1472/Fric.o ${OBJECTDIR}/_ext/1472/Telem.o ${OBJECTDIR}/_ext/1472/Uart.o
 
 # Source Files
-SOURCEFILES=../main.c ../MtrCtrl.c ../spi.c ../util.c
+SOURCEFILES=../main.c ../MtrCtrl.c ../spi.c ../util.c ../Encoder.c ../Timebase.c ../Pwm.c ../fixmath.c ../Odom.c ../Pid.c ../Control.c ../Ffwd.c ../Tune.c ../Profile.c ../Move.c ../Fric.c ../Telem.c ../Uart.c
 
 
 CFLAGS=
@@ -130,6 +130,90 @@ ${OBJECTDIR}/_ext/1472/util.o: ../util.c  nbproject/Makefile-${CND_CONF}.mk
 	@${RM} ${OBJECTDIR}/_ext/1472/util.o 
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/util.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/util.o.d" -o ${OBJECTDIR}/_ext/1472/util.o ../util.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
 	
+${OBJECTDIR}/_ext/1472/Encoder.o: ../Encoder.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Encoder.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Encoder.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Encoder.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Encoder.o.d" -o ${OBJECTDIR}/_ext/1472/Encoder.o ../Encoder.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Timebase.o: ../Timebase.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Timebase.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Timebase.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Timebase.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Timebase.o.d" -o ${OBJECTDIR}/_ext/1472/Timebase.o ../Timebase.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Pwm.o: ../Pwm.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Pwm.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Pwm.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Pwm.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Pwm.o.d" -o ${OBJECTDIR}/_ext/1472/Pwm.o ../Pwm.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/fixmath.o: ../fixmath.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/fixmath.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/fixmath.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/fixmath.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/fixmath.o.d" -o ${OBJECTDIR}/_ext/1472/fixmath.o ../fixmath.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Odom.o: ../Odom.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Odom.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Odom.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Odom.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Odom.o.d" -o ${OBJECTDIR}/_ext/1472/Odom.o ../Odom.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Pid.o: ../Pid.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Pid.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Pid.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Pid.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Pid.o.d" -o ${OBJECTDIR}/_ext/1472/Pid.o ../Pid.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Control.o: ../Control.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Control.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Control.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Control.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Control.o.d" -o ${OBJECTDIR}/_ext/1472/Control.o ../Control.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Ffwd.o: ../Ffwd.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Ffwd.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Ffwd.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Ffwd.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Ffwd.o.d" -o ${OBJECTDIR}/_ext/1472/Ffwd.o ../Ffwd.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Tune.o: ../Tune.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Tune.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Tune.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Tune.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Tune.o.d" -o ${OBJECTDIR}/_ext/1472/Tune.o ../Tune.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Profile.o: ../Profile.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Profile.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Profile.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Profile.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Profile.o.d" -o ${OBJECTDIR}/_ext/1472/Profile.o ../Profile.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Move.o: ../Move.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Move.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Move.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Move.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Move.o.d" -o ${OBJECTDIR}/_ext/1472/Move.o ../Move.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Fric.o: ../Fric.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Fric.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Fric.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Fric.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Fric.o.d" -o ${OBJECTDIR}/_ext/1472/Fric.o ../Fric.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Telem.o: ../Telem.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Telem.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Telem.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Telem.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Telem.o.d" -o ${OBJECTDIR}/_ext/1472/Telem.o ../Telem.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Uart.o: ../Uart.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Uart.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Uart.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Uart.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Uart.o.d" -o ${OBJECTDIR}/_ext/1472/Uart.o ../Uart.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
 else
 ${OBJECTDIR}/_ext/1472/main.o: ../main.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
@@ -155,6 +239,90 @@ ${OBJECTDIR}/_ext/1472/util.o: ../util.c  nbproject/Makefile-${CND_CONF}.mk
 	@${RM} ${OBJECTDIR}/_ext/1472/util.o 
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/util.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/util.o.d" -o ${OBJECTDIR}/_ext/1472/util.o ../util.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
 	
+${OBJECTDIR}/_ext/1472/Encoder.o: ../Encoder.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Encoder.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Encoder.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Encoder.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Encoder.o.d" -o ${OBJECTDIR}/_ext/1472/Encoder.o ../Encoder.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Timebase.o: ../Timebase.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Timebase.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Timebase.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Timebase.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Timebase.o.d" -o ${OBJECTDIR}/_ext/1472/Timebase.o ../Timebase.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Pwm.o: ../Pwm.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Pwm.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Pwm.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Pwm.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Pwm.o.d" -o ${OBJECTDIR}/_ext/1472/Pwm.o ../Pwm.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/fixmath.o: ../fixmath.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/fixmath.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/fixmath.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/fixmath.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/fixmath.o.d" -o ${OBJECTDIR}/_ext/1472/fixmath.o ../fixmath.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Odom.o: ../Odom.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Odom.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Odom.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Odom.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Odom.o.d" -o ${OBJECTDIR}/_ext/1472/Odom.o ../Odom.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Pid.o: ../Pid.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Pid.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Pid.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Pid.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Pid.o.d" -o ${OBJECTDIR}/_ext/1472/Pid.o ../Pid.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Control.o: ../Control.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Control.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Control.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Control.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Control.o.d" -o ${OBJECTDIR}/_ext/1472/Control.o ../Control.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Ffwd.o: ../Ffwd.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Ffwd.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Ffwd.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Ffwd.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Ffwd.o.d" -o ${OBJECTDIR}/_ext/1472/Ffwd.o ../Ffwd.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Tune.o: ../Tune.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Tune.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Tune.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Tune.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Tune.o.d" -o ${OBJECTDIR}/_ext/1472/Tune.o ../Tune.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Profile.o: ../Profile.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Profile.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Profile.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Profile.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Profile.o.d" -o ${OBJECTDIR}/_ext/1472/Profile.o ../Profile.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Move.o: ../Move.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Move.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Move.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Move.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Move.o.d" -o ${OBJECTDIR}/_ext/1472/Move.o ../Move.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Fric.o: ../Fric.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Fric.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Fric.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Fric.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Fric.o.d" -o ${OBJECTDIR}/_ext/1472/Fric.o ../Fric.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Telem.o: ../Telem.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Telem.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Telem.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Telem.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Telem.o.d" -o ${OBJECTDIR}/_ext/1472/Telem.o ../Telem.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/_ext/1472/Uart.o: ../Uart.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
+	@${RM} ${OBJECTDIR}/_ext/1472/Uart.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1472/Uart.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1472/Uart.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I".." -I"." -MMD -MF "${OBJECTDIR}/_ext/1472/Uart.o.d" -o ${OBJECTDIR}/_ext/1472/Uart.o ../Uart.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD) 
+	
 endif
 
 # ------------------------------------------------------------------------------------
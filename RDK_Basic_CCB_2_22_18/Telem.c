@@ -0,0 +1,583 @@
+/************************************************************************/
+/*																		*/
+/*	Telem.c	--  Telemetry Recorder                                      */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the telemetry sample pool and  */
+/*  for configuring, recording and reading it back, for the triggered   */
+/*  scope capture, and for sending the records as UART frames.          */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <plib.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Uart.h"
+#include "Telem.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+struct telem	telem;
+int16_t			rgsTelem[csTelemPool];
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	void	TelemSendRec(const int16_t * rgs, WORD tus);
+static	void	TelemSendChan(void);
+static	void	TelemScopeStep(void);
+static	void	TelemSendCap(void);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	FTelemConfig
+**
+**	Synopsis:
+**		f = FTelemConfig(rgch, cch, crec, mode)
+**
+**	Parameters:
+**		rgch - channel list; must stay valid while recording
+**		cch  - number of channels, 1 to cchTelemMax
+**		crec - records to keep; 0 for as many as fit
+**		mode - modeTelemRing or modeTelemOnce
+**
+**	Return Values:
+**		fTrue if the recorder was set up
+**
+**	Errors:
+**		fails for a bad channel count or mode
+**
+**	Description:
+**		Stops recording and streaming and empties the buffer. A crec
+**		larger than the pool allows is cut down to fit. Call
+**		TelemStart or TelemStream to begin.
+*/
+
+BOOL FTelemConfig(const struct telemch * rgch, BYTE cch, HWORD crec, BYTE mode)
+{
+	unsigned int	st;
+	HWORD			crecFit;
+
+	if ( ( cch == 0 ) || ( cch > cchTelemMax ) ||
+		 ( ( mode != modeTelemRing ) && ( mode != modeTelemOnce ) ) ) {
+		return fFalse;
+	}
+
+	crecFit = csTelemPool / cch;
+	if ( ( crec == 0 ) || ( crec > crecFit ) ) {
+		crec = crecFit;
+	}
+
+	st = INTDisableInterrupts();
+	telem.fRun		= fFalse;
+	telem.fStream	= fFalse;
+	telem.rgch		= rgch;
+	telem.cch		= cch;
+	telem.mode		= mode;
+	telem.crecMax	= crec;
+	telem.irec		= 0;
+	telem.crec		= 0;
+	telem.crecTotal	= 0;
+	telem.stScope	= stTelemFill;
+	INTRestoreInterrupts(st);
+
+	return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***	TelemStart
+**
+**	Synopsis:
+**		TelemStart()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Empties the buffer and starts recording. In scope mode this
+**		also re-arms the trigger.
+*/
+
+void TelemStart(void)
+{
+	unsigned int	st;
+
+	st = INTDisableInterrupts();
+	telem.irec		= 0;
+	telem.crec		= 0;
+	telem.stScope	= stTelemFill;
+	telem.fbTrig	= 0;
+	telem.irecDump	= 0;
+	telem.fRun		= ( telem.cch != 0 );
+	INTRestoreInterrupts(st);
+}
+
+/* ------------------------------------------------------------ */
+/***	TelemStop
+**
+**	Synopsis:
+**		TelemStop()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Stops recording and keeps what has been recorded.
+*/
+
+void TelemStop(void)
+{
+	telem.fRun = fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***	FTelemScope
+**
+**	Synopsis:
+**		f = FTelemScope(crecPre, crecPost)
+**
+**	Parameters:
+**		crecPre  - records to keep from before the trigger
+**		crecPost - records to take from the trigger on, at least 1
+**
+**	Return Values:
+**		fTrue if scope mode was set up
+**
+**	Errors:
+**		fails if the recorder has no channels or the two depths do
+**		not fit in the pool together
+**
+**	Description:
+**		Puts the configured recorder into scope mode and starts it.
+**		The channels stay as FTelemConfig set them. Once telem.stScope
+**		is stTelemHeld, FTelemGetRec record crecPre is the trigger
+**		record.
+*/
+
+BOOL FTelemScope(HWORD crecPre, HWORD crecPost)
+{
+	unsigned int	st;
+
+	if ( ( telem.cch == 0 ) || ( crecPost == 0 ) ||
+		 ( (WORD)crecPre + crecPost > csTelemPool / telem.cch ) ) {
+		return fFalse;
+	}
+
+	st = INTDisableInterrupts();
+	telem.mode		= modeTelemScope;
+	telem.crecPre	= crecPre;
+	telem.crecPost	= crecPost;
+	telem.crecMax	= crecPre + crecPost;
+	TelemStart();
+	INTRestoreInterrupts(st);
+
+	return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***	TelemTrigger
+**
+**	Synopsis:
+**		TelemTrigger(fbSrc)
+**
+**	Parameters:
+**		fbSrc - caller's bits for what triggered
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Triggers the scope capture at the next record, if it is
+**		armed by then. Can be called at any priority.
+*/
+
+void TelemTrigger(BYTE fbSrc)
+{
+	unsigned int	st;
+
+	st = INTDisableInterrupts();
+	telem.fbTrig |= fbSrc;
+	INTRestoreInterrupts(st);
+}
+
+/* ------------------------------------------------------------ */
+/***	TelemStream
+**
+**	Synopsis:
+**		TelemStream(fOn)
+**
+**	Parameters:
+**		fOn - send the records on the UART
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Starts or stops streaming. The stream starts with a channel
+**		frame. UartInit must have been called.
+*/
+
+void TelemStream(BOOL fOn)
+{
+	unsigned int	st;
+
+	st = INTDisableInterrupts();
+	telem.crecChan	= 0;
+	telem.fStream	= fOn && ( telem.cch != 0 );
+	INTRestoreInterrupts(st);
+}
+
+/* ------------------------------------------------------------ */
+/***	TelemRecord
+**
+**	Synopsis:
+**		TelemRecord(tus)
+**
+**	Parameters:
+**		tus - time of the samples, microseconds
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Takes one record, into the buffer while recording and onto
+**		the stream while streaming. Called by the control tick; does
+**		nothing while both are stopped. A held scope capture is sent
+**		here too, a few records per call, while streaming.
+*/
+
+void TelemRecord(WORD tus)
+{
+	const struct telemch *	pch;
+	int16_t		rgsStream[cchTelemMax];
+	int16_t *	psRec;
+	int16_t *	ps;
+	BYTE		ich;
+
+	if ( !telem.fRun && !telem.fStream ) {
+		return;
+	}
+
+	psRec = telem.fRun ? &rgsTelem[telem.irec * telem.cch] : rgsStream;
+	pch = telem.rgch;
+	ps = psRec;
+	for ( ich = 0; ich < telem.cch; ich++, pch++ ) {
+		*ps++ = (int16_t)( *pch->pq >> pch->bnShift );
+	}
+	telem.crecTotal++;
+
+	if ( telem.fStream ) {
+		TelemSendRec(psRec, tus);
+	}
+
+	if ( telem.fRun ) {
+		if ( telem.crec < telem.crecMax ) {
+			telem.crec++;
+		}
+		if ( ++telem.irec >= telem.crecMax ) {
+			telem.irec = 0;
+			if ( telem.mode == modeTelemOnce ) {
+				telem.fRun = fFalse;
+			}
+		}
+		if ( telem.mode == modeTelemScope ) {
+			TelemScopeStep();
+		}
+	}
+
+	// The live record goes first, so the capture only takes what
+	// room is left.
+	if ( telem.fStream && ( telem.stScope == stTelemHeld ) ) {
+		TelemSendCap();
+	}
+}
+
+/* ------------------------------------------------------------ */
+/***	FTelemGetRec
+**
+**	Synopsis:
+**		f = FTelemGetRec(irec, rgs)
+**
+**	Parameters:
+**		irec - record number, 0 for the oldest held
+**		rgs  - receives telem.cch samples
+**
+**	Return Values:
+**		fTrue if the record is held
+**
+**	Errors:
+**		fails past the newest record
+**
+**	Description:
+**		Copies out one record. Stop the recorder first to read a
+**		consistent set, or the oldest records may be overwritten
+**		while they are read.
+*/
+
+BOOL FTelemGetRec(HWORD irec, int16_t * rgs)
+{
+	int16_t *	ps;
+	HWORD		irecBuf;
+	BYTE		ich;
+
+	if ( irec >= telem.crec ) {
+		return fFalse;
+	}
+
+	// Once the buffer has wrapped the oldest record is the next one out.
+	irecBuf = irec;
+	if ( telem.crec == telem.crecMax ) {
+		irecBuf += telem.irec;
+		if ( irecBuf >= telem.crecMax ) {
+			irecBuf -= telem.crecMax;
+		}
+	}
+
+	ps = &rgsTelem[irecBuf * telem.cch];
+	for ( ich = 0; ich < telem.cch; ich++ ) {
+		rgs[ich] = ps[ich];
+	}
+
+	return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***	TelemSendRec
+**
+**	Synopsis:
+**		TelemSendRec(rgs, tus)
+**
+**	Parameters:
+**		rgs - samples of the record just taken
+**		tus - its time, microseconds
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		a frame the UART has no room for is lost; the sequence
+**		numbers show the gap
+**
+**	Description:
+**		Queues the record frame, after a channel frame if one is
+**		due.
+*/
+
+static void TelemSendRec(const int16_t * rgs, WORD tus)
+{
+	BYTE	rgb[cbTelemRecHdr + ( 2 * cchTelemMax )];
+	BYTE *	pb = rgb;
+	HWORD	seq = (HWORD)telem.crecTotal;
+	BYTE	ich;
+
+	if ( telem.crecChan == 0 ) {
+		TelemSendChan();
+		telem.crecChan = crecTelemChan;
+	}
+	telem.crecChan--;
+
+	*pb++ = ftypTelemRec;
+	*pb++ = telem.cch;
+	*pb++ = (BYTE)seq;
+	*pb++ = (BYTE)( seq >> 8 );
+	*pb++ = (BYTE)tus;
+	*pb++ = (BYTE)( tus >> 8 );
+	*pb++ = (BYTE)( tus >> 16 );
+	*pb++ = (BYTE)( tus >> 24 );
+	for ( ich = 0; ich < telem.cch; ich++ ) {
+		*pb++ = (BYTE)rgs[ich];
+		*pb++ = (BYTE)( rgs[ich] >> 8 );
+	}
+
+	FUartSendFrame(rgb, pb - rgb);
+}
+
+/* ------------------------------------------------------------ */
+/***	TelemSendChan
+**
+**	Synopsis:
+**		TelemSendChan()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Queues a channel frame.
+*/
+
+static void TelemSendChan(void)
+{
+	BYTE	rgb[2 + cchTelemMax];
+	BYTE	ich;
+
+	rgb[0] = ftypTelemChan;
+	rgb[1] = telem.cch;
+	for ( ich = 0; ich < telem.cch; ich++ ) {
+		rgb[2 + ich] = telem.rgch[ich].bnShift;
+	}
+
+	FUartSendFrame(rgb, 2 + telem.cch);
+}
+
+/* ------------------------------------------------------------ */
+/***	TelemScopeStep
+**
+**	Synopsis:
+**		TelemScopeStep()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Advances the scope after a record has been stored. A trigger
+**		makes the record just taken the first post-trigger one;
+**		triggers that come while the scope is not armed are dropped.
+*/
+
+static void TelemScopeStep(void)
+{
+	switch ( telem.stScope ) {
+		case stTelemFill:
+			if ( telem.crec >= telem.crecPre ) {
+				telem.stScope = stTelemArmed;
+			}
+			break;
+
+		case stTelemArmed:
+			if ( telem.fbTrig != 0 ) {
+				telem.fbTrigHit	= telem.fbTrig;
+				telem.crecLeft	= telem.crecPost;
+				telem.stScope	= stTelemPost;
+			}
+			break;
+	}
+
+	if ( telem.stScope == stTelemPost ) {
+		if ( --telem.crecLeft == 0 ) {
+			telem.fRun		= fFalse;
+			telem.irecDump	= 0;
+			telem.stScope	= stTelemHeld;
+			telem.icap++;
+		}
+	}
+
+	telem.fbTrig = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	TelemSendCap
+**
+**	Synopsis:
+**		TelemSendCap()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Queues the next crecTelemDump records of the held capture.
+**		A record the UART has no room for waits for the next call,
+**		so none are lost. Once the last one is out the scope is
+**		re-armed.
+*/
+
+static void TelemSendCap(void)
+{
+	BYTE	rgb[cbTelemCapHdr + ( 2 * cchTelemMax )];
+	int16_t	rgs[cchTelemMax];
+	BYTE *	pb;
+	HWORD	irec;
+	BYTE	crecSent;
+	BYTE	ich;
+
+	for ( crecSent = 0; crecSent < crecTelemDump; crecSent++ ) {
+		irec = telem.irecDump;
+		if ( !FTelemGetRec(irec, rgs) ) {
+			TelemStart();
+			return;
+		}
+
+		pb = rgb;
+		*pb++ = ftypTelemCap;
+		*pb++ = telem.cch;
+		*pb++ = telem.fbTrigHit;
+		*pb++ = telem.icap;
+		*pb++ = (BYTE)irec;
+		*pb++ = (BYTE)( irec >> 8 );
+		*pb++ = (BYTE)telem.crec;
+		*pb++ = (BYTE)( telem.crec >> 8 );
+		*pb++ = (BYTE)telem.crecPre;
+		*pb++ = (BYTE)( telem.crecPre >> 8 );
+		for ( ich = 0; ich < telem.cch; ich++ ) {
+			*pb++ = (BYTE)rgs[ich];
+			*pb++ = (BYTE)( rgs[ich] >> 8 );
+		}
+
+		if ( !FUartRoom(pb - rgb) ) {
+			return;
+		}
+		FUartSendFrame(rgb, pb - rgb);
+		telem.irecDump++;
+	}
+}
+
+/************************************************************************/
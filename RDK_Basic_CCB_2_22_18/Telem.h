@@ -0,0 +1,155 @@
+/************************************************************************/
+/*																		*/
+/*	Telem.h	--  Telemetry Recorder                                      */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for recording controller signals  */
+/*  at the control rate. A record is one 16-bit sample of each channel  */
+/*  in the channel list, stored together, and the records go into a     */
+/*  fixed pool of cbTelemPool bytes: as many of them as the channel     */
+/*  count allows, or fewer if asked.                                    */
+/*																		*/
+/*  A channel is a Q16 variable and a right shift, so taking a sample   */
+/*  is a load, a shift and a store, and a record costs the same every   */
+/*  tick. Pick the shift to fit the range into 16 bits: bnTelemSpd      */
+/*  keeps speeds in Q12 ft/s, bnTelemDtc keeps duty cycles in whole     */
+/*  microseconds.                                                       */
+/*																		*/
+/*  In ring mode the newest record overwrites the oldest; in one-shot   */
+/*  mode recording stops once the buffer is full. TelemGetRec reads     */
+/*  the records back oldest first, and the pool can also be read raw    */
+/*  in the debugger.                                                    */
+/*																		*/
+/*  Scope mode (FTelemScope) keeps a transient instead: the ring runs   */
+/*  until TelemTrigger is called, then takes crecPost more records and  */
+/*  holds, so the buffer has the crecPre records before the trigger and */
+/*  the crecPost from it on. Triggers are ignored until crecPre records */
+/*  are in, and while a capture is taken or held. A held capture stays  */
+/*  until TelemStart re-arms the recorder, or, while streaming, until it*/
+/*  has been sent as capture frames, after which it re-arms by itself.  */
+/*																		*/
+/*  With TelemStream on, every record is also sent as a frame on the    */
+/*  UART (Uart.h), whether or not it is kept in the buffer, and every   */
+/*  crecTelemChan records a channel frame gives the shifts needed to    */
+/*  scale the samples. host/telemdec.c turns the stream into CSV.       */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_TELEM_INC)
+#define _TELEM_INC
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Sample pool size, bytes, and the most channels in a record. Six
+**	channels of 16 bits leave 256 records.
+*/
+#define	cbTelemPool		3072
+#define	csTelemPool		( cbTelemPool / sizeof(int16_t) )
+#define	cchTelemMax		8
+
+/*	Shifts from Q16 for the common signals.
+*/
+#define	bnTelemSpd		4		// Q12 ft/s, up to 8 ft/s
+#define	bnTelemDtc		16		// OC duty, microseconds
+
+#define	modeTelemRing	0
+#define	modeTelemOnce	1
+#define	modeTelemScope	2
+
+/*	Scope states.
+*/
+#define	stTelemFill		0		// taking the pre-trigger records
+#define	stTelemArmed	1		// waiting for a trigger
+#define	stTelemPost		2		// taking the post-trigger records
+#define	stTelemHeld		3		// capture complete
+
+/*	Stream frames, ahead of the CRC and COBS framing; fields are little
+**	endian. A record frame is the type, the channel count, the low 16
+**	bits of crecTotal as a sequence number, the control tick time in
+**	microseconds (32 bits) and the samples. A channel frame is the
+**	type, the channel count and the shift of each channel. A capture
+**	frame is the type, the channel count, the trigger sources, the
+**	capture number (8 bits), the record number, the records in the
+**	capture, the record number of the trigger and the samples; up to
+**	crecTelemDump of them go out per record taken.
+*/
+#define	ftypTelemRec	1
+#define	ftypTelemChan	2
+#define	ftypTelemCap	3
+#define	cbTelemRecHdr	8
+#define	cbTelemCapHdr	10
+#define	crecTelemChan	64
+#define	crecTelemDump	4
+
+/*	Channel: sample = *pq >> bnShift.
+*/
+struct telemch {
+	const volatile Q16 *	pq;
+	BYTE					bnShift;
+};
+
+/*	Recorder state. irec is where the next record goes; crec counts
+**	the records held, up to crecMax. crecTotal counts every record
+**	taken since the start. In scope mode crecMax is crecPre + crecPost,
+**	fbTrig collects TelemTrigger sources until the next record, and
+**	fbTrigHit keeps the ones that started the capture.
+*/
+struct telem {
+	const struct telemch *	rgch;
+	BYTE			cch;
+	BYTE			mode;
+	volatile BOOL	fRun;
+	volatile BOOL	fStream;
+	HWORD			crecChan;		// records until the next channel frame
+	HWORD			crecMax;
+	volatile HWORD	irec;
+	volatile HWORD	crec;
+	volatile WORD	crecTotal;
+	HWORD			crecPre;
+	HWORD			crecPost;
+	HWORD			crecLeft;		// post-trigger records still to take
+	volatile BYTE	stScope;
+	volatile BYTE	fbTrig;
+	BYTE			fbTrigHit;
+	BYTE			icap;			// captures completed
+	HWORD			irecDump;		// next capture record to send
+};
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	struct telem	telem;
+extern	int16_t			rgsTelem[csTelemPool];
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+BOOL	FTelemConfig(const struct telemch * rgch, BYTE cch, HWORD crec, BYTE mode);
+void	TelemStart(void);
+void	TelemStop(void);
+BOOL	FTelemScope(HWORD crecPre, HWORD crecPost);
+void	TelemTrigger(BYTE fbSrc);
+void	TelemStream(BOOL fOn);
+void	TelemRecord(WORD tus);
+BOOL	FTelemGetRec(HWORD irec, int16_t * rgs);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
@@ -0,0 +1,236 @@
+/************************************************************************/
+/*																		*/
+/*	Timebase.c	--  Extended Microsecond Timebase                       */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the 64-bit microsecond clock.  */
+/*  Timer3Handler (IPL5) counts overflows. Readers running at a higher  */
+/*  priority can see Timer 3 wrapped with the interrupt still pending,  */
+/*  and readers at a lower priority can be preempted by the handler in  */
+/*  the middle of a read. TbNowUs and TbCaptureUs handle both cases     */
+/*  by checking the pending flag and re-reading the count. The handler  */
+/*  clears the flag and counts the overflow with interrupts disabled,   */
+/*  so a higher priority reader never finds it between the two.         */
+/*																		*/
+/*  With OPT_TB32 the same code runs on the cascaded Timer 2/3 pair,    */
+/*  whose interrupt is the Timer 3 one. It overflows once every 71.6    */
+/*  minutes, and only TbNowUs needs the overflow count.                 */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <plib.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "Timebase.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	bnT3If			12	// Bit in IFS0 register for T3's interrupt flag
+#define	bnT3Ie			12	// Bit in IEC0 register for T3's enable
+#define	bnTxT32			3	// T2CON: cascade Timer 2 and 3
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+static	volatile	WORD	cTbOvf = 0;	// timebase overflows since TbInit
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	void	TbSnap(WORD * pcOvf, WORD * ptck);
+
+/* ------------------------------------------------------------ */
+/*				Interrupt Service Routines	            	    */
+/* ------------------------------------------------------------ */
+
+void __ISR(_TIMER_3_VECTOR, ipl5) Timer3Handler(void)
+{
+	unsigned int	st;
+
+	// A reader at a higher priority must not see the flag clear and
+	// the old count, so nothing may run between these two.
+	st = INTDisableInterrupts();
+	IFS0CLR = ( 1 << bnT3If ); //clear T3 interrupt flag
+	cTbOvf++;
+	INTRestoreInterrupts(st);
+}
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	TbInit
+**
+**	Synopsis:
+**		TbInit()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Configures Timer 3 for 1 us ticks with a 50 ms period, or
+**		with OPT_TB32 the Timer 2/3 pair for 1 us ticks over the full
+**		32-bit range, and enables the overflow interrupt at level 5,
+**		sub 3.
+*/
+
+void TbInit(void)
+{
+#if OPT_TB32
+	T2CON	= 0;
+	T3CON	= 0;
+	TMR2	= 0;
+	PR2		= 0xFFFFFFFF;
+#else
+	T3CON	= 0;
+	TMR3	= 0;
+	PR3		= tusTbPeriod - 1;
+#endif
+
+	IPC3SET = ( 1 << 4 ) | ( 1 << 2 ) | ( 1 << 1 ) | ( 1 << 0 );
+	IFS0CLR = ( 1 << bnT3If );
+	IEC0SET = ( 1 << bnT3Ie );
+
+	// Bit 15 is the enable; setting TCKPS = [011] results in prescaler of 8
+#if OPT_TB32
+	T2CON	= ( 1 << 15 ) | ( 1 << 5 ) | ( 1 << 4 ) | ( 1 << bnTxT32 );
+#else
+	T3CON	= ( 1 << 15 ) | ( 1 << 5 ) | ( 1 << 4 );
+#endif
+}
+
+/* ------------------------------------------------------------ */
+/***	TbSnap
+**
+**	Synopsis:
+**		TbSnap(pcOvf, ptck)
+**
+**	Parameters:
+**		pcOvf - receives the overflow count
+**		ptck  - receives the timer count
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Reads an overflow count and timer value that belong to the same
+**		timer period. If the timer has wrapped but Timer3Handler has
+**		not run yet, the pending overflow is counted here and the timer
+**		is read again so the value is known to be after the wrap. If
+**		Timer3Handler runs during the read, the read is retried.
+*/
+
+static void TbSnap(WORD * pcOvf, WORD * ptck)
+{
+	WORD	cOvf;
+	WORD	tck;
+
+	do {
+		cOvf = cTbOvf;
+		tck = TMRTB;
+		if ( IFS0 & ( 1 << bnT3If ) ) {
+			tck = TMRTB;
+			*pcOvf = cOvf + 1;
+		}
+		else {
+			*pcOvf = cOvf;
+		}
+	} while ( cOvf != cTbOvf );
+
+	*ptck = tck;
+}
+
+/* ------------------------------------------------------------ */
+/***	TbNowUs
+**
+**	Synopsis:
+**		tus = TbNowUs()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		microseconds since TbInit
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Returns the current time. Safe to call from any priority.
+*/
+
+DWORD TbNowUs(void)
+{
+	WORD	cOvf;
+	WORD	tck;
+
+	TbSnap(&cOvf, &tck);
+	return ( (DWORD)cOvf * tusTbPeriod ) + tck;
+}
+
+#if !OPT_TB32
+/* ------------------------------------------------------------ */
+/***	TbCaptureUs
+**
+**	Synopsis:
+**		tus = TbCaptureUs(tckCap)
+**
+**	Parameters:
+**		tckCap - 16-bit Timer 3 value read from an ICxBUF
+**
+**	Return Values:
+**		microseconds since TbInit at which the capture happened
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Extends a Timer 3 input capture value to the 64-bit clock. A
+**		capture value larger than the current timer value was taken
+**		before the most recent wrap. The capture must be less than one
+**		Timer 3 period (50 ms) old, which holds as long as the capture
+**		FIFO is drained by its ISR.
+*/
+
+DWORD TbCaptureUs(HWORD tckCap)
+{
+	WORD	cOvf;
+	WORD	tck;
+
+	TbSnap(&cOvf, &tck);
+	if ( ( tckCap > tck ) && ( cOvf > 0 ) ) {
+		cOvf--;
+	}
+	return ( (DWORD)cOvf * tusTbPeriod ) + tckCap;
+}
+#endif
+
+/************************************************************************/
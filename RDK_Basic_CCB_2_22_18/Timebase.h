@@ -0,0 +1,59 @@
+/************************************************************************/
+/*																		*/
+/*	Timebase.h	--  Extended Microsecond Timebase                       */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for a 64-bit microsecond clock    */
+/*  built from Timer 3 and a count of its overflows. Timer 3 is also    */
+/*  the input capture timebase, so capture values can be extended to    */
+/*  the same clock.                                                     */
+/*																		*/
+/*  With OPT_TB32 Timers 2 and 3 are cascaded into one free-running     */
+/*  32-bit timer and input capture runs in 32-bit mode, so a capture    */
+/*  value already is the low 32 bits of the clock.                      */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_TIMEBASE_INC)
+#define _TIMEBASE_INC
+
+#include "config.h"
+#include "stdtypes.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Timer 3 (or the Timer 2/3 pair) runs at Fpb / 8 = 1 MHz. Timer 3
+**	alone wraps every 50 ms; the 32-bit pair wraps every 71.6 minutes.
+*/
+#if OPT_TB32
+#define	tusTbPeriod		0x100000000ULL
+#define	TMRTB			TMR2	// 32-bit count of the pair
+#else
+#define	tusTbPeriod		50000
+#define	TMRTB			TMR3
+#endif
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+void	TbInit(void);
+DWORD	TbNowUs(void);
+#if !OPT_TB32
+DWORD	TbCaptureUs(HWORD tckCap);
+#endif
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
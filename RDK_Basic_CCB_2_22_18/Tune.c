@@ -0,0 +1,313 @@
+/************************************************************************/
+/*																		*/
+/*	Tune.c	--  Relay Feedback PID Autotune                             */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the relay experiment that      */
+/*  runs in the control tick, and for turning its result into PID       */
+/*  gains.                                                              */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <math.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Pid.h"
+#include "Pwm.h"
+#include "Control.h"
+#include "Tune.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	cTickTuneMax	( tusTuneMax / tusCtrlTick )
+
+/*	Largest gain accepted from a tune; PidSetGains takes Q16.
+*/
+#define	kTuneMax		30000.0f
+
+#define	flPi			3.14159265f
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+struct tune	tuneLeft;
+struct tune	tuneRight;
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	BOOL	FTuneBegin(struct tune * ptune, struct pid * ppid, Q16 spdSet, Q16 spd);
+static	BOOL	FTuneApply(struct tune * ptune, struct pid * ppid, Q16 spdSet, Q16 spd);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	TuneStart
+**
+**	Synopsis:
+**		TuneStart()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Asks the control tick to tune both wheels. Each wheel starts
+**		at the next tick; a wheel already tuning is left alone. Start
+**		with the wheels running steadily at their setpoints, since
+**		the PID outputs at that moment become the relay centers.
+*/
+
+void TuneStart(void)
+{
+	if ( tuneLeft.st != stTuneRun ) {
+		tuneLeft.fReq = fTrue;
+	}
+	if ( tuneRight.st != stTuneRun ) {
+		tuneRight.fReq = fTrue;
+	}
+}
+
+/* ------------------------------------------------------------ */
+/***	FTuneRunning
+**
+**	Synopsis:
+**		f = FTuneRunning()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		fTrue if either wheel is tuning or about to start
+**
+**	Errors:
+**		none
+*/
+
+BOOL FTuneRunning(void)
+{
+	return tuneLeft.fReq || tuneRight.fReq ||
+		   ( tuneLeft.st == stTuneRun ) || ( tuneRight.st == stTuneRun );
+}
+
+/* ------------------------------------------------------------ */
+/***	FTuneTick
+**
+**	Synopsis:
+**		f = FTuneTick(ptune, ppid, spdSet, spd, pdtc)
+**
+**	Parameters:
+**		ptune  - tune state of the wheel
+**		ppid   - PID of the wheel; gets the new gains
+**		spdSet - speed setpoint, ft/s
+**		spd    - speed the PID would see this tick, ft/s
+**		pdtc   - receives the relay duty cycle, Q16
+**
+**	Return Values:
+**		fTrue if the relay drives the wheel this tick; fFalse if the
+**		PID should run as usual
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Called once per control tick for each wheel. A cycle runs
+**		from one rising switch of the relay to the next. After
+**		cTuneSkip cycles the amplitude and length of the next
+**		cTuneCycle cycles are averaged, and the gains are applied.
+*/
+
+BOOL FTuneTick(struct tune * ptune, struct pid * ppid, Q16 spdSet, Q16 spd, Q16 * pdtc)
+{
+	if ( ptune->st != stTuneRun ) {
+		if ( !ptune->fReq ) {
+			return fFalse;
+		}
+		ptune->fReq = fFalse;
+		if ( !FTuneBegin(ptune, ppid, spdSet, spd) ) {
+			return fFalse;
+		}
+	}
+
+	ptune->cTick++;
+	ptune->cTickCycle++;
+
+	if ( spd > ptune->spdMax ) {
+		ptune->spdMax = spd;
+	}
+	if ( spd < ptune->spdMin ) {
+		ptune->spdMin = spd;
+	}
+
+	if ( !ptune->fHigh && ( spd < spdSet - spdTuneHyst ) ) {
+		ptune->fHigh = fTrue;
+		ptune->cCycle++;
+
+		// The cycle that just ended is number cCycle - 1.
+		if ( ptune->cCycle > cTuneSkip + 1 ) {
+			ptune->spdAmpSum += ( ptune->spdMax - ptune->spdMin ) / 2;
+			ptune->cTickSum += ptune->cTickCycle;
+		}
+		ptune->cTickCycle = 0;
+		ptune->spdMax = spd;
+		ptune->spdMin = spd;
+
+		if ( ptune->cCycle >= cTuneSkip + 1 + cTuneCycle ) {
+			ptune->st = FTuneApply(ptune, ppid, spdSet, spd) ? stTuneDone : stTuneFail;
+			return fFalse;
+		}
+	}
+	else if ( ptune->fHigh && ( spd > spdSet + spdTuneHyst ) ) {
+		ptune->fHigh = fFalse;
+	}
+
+	if ( ptune->cTick >= cTickTuneMax ) {
+		ptune->st = stTuneFail;
+		return fFalse;
+	}
+
+	*pdtc = ptune->fHigh ? ptune->dtcBias + ptune->dtcRelay
+						 : ptune->dtcBias - ptune->dtcRelay;
+	return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***	FTuneBegin
+**
+**	Synopsis:
+**		f = FTuneBegin(ptune, ppid, spdSet, spd)
+**
+**	Parameters:
+**		ptune  - tune state of the wheel
+**		ppid   - PID of the wheel
+**		spdSet - speed setpoint, ft/s
+**		spd    - speed this tick, ft/s
+**
+**	Return Values:
+**		fTrue if the tune started
+**
+**	Errors:
+**		fails, with st = stTuneFail, if the PID output is at a limit
+**		and leaves no room for the relay
+**
+**	Description:
+**		Centers the relay on the present PID output and narrows it
+**		if needed to stay within the duty cycle range on the same
+**		side of zero, so the relay never reverses the motor.
+*/
+
+static BOOL FTuneBegin(struct tune * ptune, struct pid * ppid, Q16 spdSet, Q16 spd)
+{
+	Q16		dtcRelay = dtcTuneRelay;
+	Q16		dtcMag;
+
+	ptune->dtcBias = ppid->out;
+	dtcMag = ( ptune->dtcBias < 0 ) ? -ptune->dtcBias : ptune->dtcBias;
+	if ( dtcRelay > dtcMag ) {
+		dtcRelay = dtcMag;
+	}
+	if ( dtcRelay > Q16FromInt(dtcPwmMax) - dtcMag ) {
+		dtcRelay = Q16FromInt(dtcPwmMax) - dtcMag;
+	}
+	if ( dtcRelay <= 0 ) {
+		ptune->st = stTuneFail;
+		return fFalse;
+	}
+
+	ptune->dtcRelay		= dtcRelay;
+	ptune->fHigh		= ( spd < spdSet );
+	ptune->cTick		= 0;
+	ptune->cTickCycle	= 0;
+	ptune->cCycle		= 0;
+	ptune->spdMax		= spd;
+	ptune->spdMin		= spd;
+	ptune->spdAmpSum	= 0;
+	ptune->cTickSum		= 0;
+	ptune->st			= stTuneRun;
+
+	return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***	FTuneApply
+**
+**	Synopsis:
+**		f = FTuneApply(ptune, ppid, spdSet, spd)
+**
+**	Parameters:
+**		ptune  - tune state of the wheel, with the sums complete
+**		ppid   - PID to receive the gains
+**		spdSet - speed setpoint, ft/s
+**		spd    - speed this tick, ft/s
+**
+**	Return Values:
+**		fTrue if the gains were applied
+**
+**	Errors:
+**		fails if the oscillation was inside the hysteresis or the
+**		gains come out too large for Q16
+**
+**	Description:
+**		Runs once per tune, so it uses float. The PID integral is
+**		in output units and carries over, so the switch back from
+**		the relay does not bump the output. The PID has not run
+**		during the relay, so its last error is brought up to date
+**		first; the gain change and the first derivative then work
+**		from the error of this tick, not the one before the tune.
+*/
+
+static BOOL FTuneApply(struct tune * ptune, struct pid * ppid, Q16 spdSet, Q16 spd)
+{
+	float	amp = FloatFromQ16( (Q16)( ptune->spdAmpSum / cTuneCycle ) );
+	float	hyst = FloatFromQ16(spdTuneHyst);
+	float	kp;
+	float	ki;
+	float	kd;
+
+	if ( amp <= hyst ) {
+		return fFalse;
+	}
+
+	ptune->ku = ( 4.0f * FloatFromQ16(ptune->dtcRelay) ) /
+				( flPi * sqrtf(amp * amp - hyst * hyst) );
+	ptune->tu = ( (float)ptune->cTickSum / cTuneCycle ) * tusCtrlTick / 1000000.0f;
+
+	kp = ptune->ku / 2.2f;
+	ki = kp / ( 2.2f * ptune->tu );
+	kd = kp * ptune->tu / 6.3f;
+
+	if ( ( kp > kTuneMax ) || ( ki > kTuneMax ) || ( kd > kTuneMax ) ) {
+		return fFalse;
+	}
+
+	ptune->kp = Q16FromFloat(kp);
+	ptune->ki = Q16FromFloat(ki);
+	ptune->kd = Q16FromFloat(kd);
+	ppid->errPrev = spdSet - spd;
+	PidSetGains(ppid, ptune->kp, ptune->ki, ptune->kd);
+
+	return fTrue;
+}
+
+/************************************************************************/
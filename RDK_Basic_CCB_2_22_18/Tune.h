@@ -0,0 +1,104 @@
+/************************************************************************/
+/*																		*/
+/*	Tune.h	--  Relay Feedback PID Autotune                             */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for tuning the wheel PIDs on the  */
+/*  robot. While a tune runs, the control tick replaces each wheel's    */
+/*  PID with a relay around its setpoint: the duty is the PID output    */
+/*  at the start plus dtcTuneRelay while the wheel is below the         */
+/*  setpoint, and minus it while above, with spdTuneHyst of             */
+/*  hysteresis. The loop settles into a limit cycle. Its amplitude a    */
+/*  and period Tu give the ultimate gain                                */
+/*																		*/
+/*		Ku = 4 d / ( pi sqrt(a^2 - hyst^2) )                            */
+/*																		*/
+/*  and the gains follow from the Tyreus-Luyben rule, which overshoots  */
+/*  less than Ziegler-Nichols and tolerates the speed noise better:     */
+/*																		*/
+/*		Kp = Ku / 2.2   Ti = 2.2 Tu   Td = Tu / 6.3                     */
+/*																		*/
+/*  Both wheels tune at once, each with its own relay; a tune takes a   */
+/*  few seconds. The new gains are applied to the PID when its wheel    */
+/*  finishes. A wheel that does not settle within tusTuneMax keeps its  */
+/*  old gains.                                                          */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_TUNE_INC)
+#define _TUNE_INC
+
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Pid.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Relay amplitude and hysteresis, the cycles skipped while the
+**	oscillation builds and the cycles averaged, and the time limit.
+*/
+#define	dtcTuneRelay	Q16FromInt(1500)
+#define	spdTuneHyst		Q16FromFloat(0.02)
+#define	cTuneSkip		2
+#define	cTuneCycle		4
+#define	tusTuneMax		8000000
+
+/*	Tune states.
+*/
+#define	stTuneIdle		0
+#define	stTuneRun		1
+#define	stTuneDone		2		// gains applied
+#define	stTuneFail		3		// timed out, gains unchanged
+
+/*	Per-wheel tune state and the result of the last tune.
+*/
+struct tune {
+	volatile BYTE	st;
+	volatile BOOL	fReq;		// start at the next control tick
+	Q16		dtcBias;		// relay center, OC duty
+	Q16		dtcRelay;		// relay amplitude, OC duty
+	BOOL	fHigh;			// relay is at dtcBias + dtcRelay
+	WORD	cTick;			// ticks since the tune started
+	WORD	cTickCycle;		// ticks since the last rising switch
+	WORD	cCycle;			// rising switches seen
+	Q16		spdMax;			// speed extremes of this cycle
+	Q16		spdMin;
+	int64_t	spdAmpSum;		// summed half peak-to-peak, ft/s
+	WORD	cTickSum;		// summed cycle lengths, ticks
+	float	ku;				// results: duty per ft/s
+	float	tu;				// seconds
+	Q16		kp;				// gains applied, as passed to PidSetGains
+	Q16		ki;
+	Q16		kd;
+};
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	struct tune	tuneLeft;
+extern	struct tune	tuneRight;
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+void	TuneStart(void);
+BOOL	FTuneTick(struct tune * ptune, struct pid * ppid, Q16 spdSet, Q16 spd, Q16 * pdtc);
+BOOL	FTuneRunning(void);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
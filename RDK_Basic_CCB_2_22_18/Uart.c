@@ -0,0 +1,280 @@
+/************************************************************************/
+/*																		*/
+/*	Uart.c	--  Framed UART Transmitter                                 */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the UART2 transmit ring, the   */
+/*  COBS encoder that fills it and the interrupt that empties it.       */
+/*																		*/
+/*  COBS replaces each zero byte with the distance to the next one: a   */
+/*  code byte n is followed by n - 1 data bytes and stands for a zero   */
+/*  after them, except for code 0xFF, which stands for 254 data bytes   */
+/*  and no zero, and the last code of the frame, which has no zero.     */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <plib.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "Uart.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	bnUartOn		15	// UxMODE
+#define	bnUartBrgh		3
+#define	bnUartTxisel	14	// UxSTA<15:14>; 2 = while the FIFO is empty
+#define	bnUartTxen		10
+#define	bnUartTxbf		9
+
+#define	IbUartNext(ib)	( ( (ib) + 1 ) & ( cbUartRing - 1 ) )
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+volatile WORD	cFrameUartSent;
+volatile WORD	cFrameUartDrop;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+/*	Transmit ring. FUartSendFrame alone moves the head, and only once
+**	a whole frame is in; the interrupt alone moves the tail.
+*/
+static	volatile BYTE	rgbUartRing[cbUartRing];
+static	volatile HWORD	ibUartHead;
+static	volatile HWORD	ibUartTail;
+
+/* ------------------------------------------------------------ */
+/*				Interrupt Service Routines	            	    */
+/* ------------------------------------------------------------ */
+/***	Uart2Handler
+**
+**	Parameters:
+**		none
+**
+**	Return Value:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Fills the transmit FIFO from the ring. Only the transmit
+**		interrupt is enabled, and only while the ring holds data.
+**		The ring is checked for empty again with interrupts off, so
+**		a frame queued meanwhile is not left waiting.
+*/
+
+void __ISR(_UART_2_VECTOR, ipl1) Uart2Handler(void)
+{
+	unsigned int	st;
+
+	IFS1CLR = ( 1 << bnU2TxIf );
+
+	while ( ( ( U2STA & ( 1 << bnUartTxbf ) ) == 0 ) && ( ibUartTail != ibUartHead ) ) {
+		U2TXREG = rgbUartRing[ibUartTail];
+		ibUartTail = IbUartNext(ibUartTail);
+	}
+
+	st = INTDisableInterrupts();
+	if ( ibUartTail == ibUartHead ) {
+		IEC1CLR = ( 1 << bnU2TxIf );
+	}
+	INTRestoreInterrupts(st);
+}
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	UartInit
+**
+**	Synopsis:
+**		UartInit()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Sets up UART2 for transmit only at baudUart, 8N1, with its
+**		interrupt at level 1, sub 3, and empties the ring.
+*/
+
+void UartInit(void)
+{
+	U2MODE	= 0;
+	U2STA	= 0;
+	U2BRG	= brgUart;
+
+	ibUartHead		= 0;
+	ibUartTail		= 0;
+	cFrameUartSent	= 0;
+	cFrameUartDrop	= 0;
+
+	IPC8SET	= ( iplUart << 2 ) | ipsUart;
+	IFS1CLR	= ( 1 << bnU2TxIf );
+
+	U2MODE	= ( 1 << bnUartBrgh );
+	U2STA	= ( 2 << bnUartTxisel );
+	U2MODESET	= ( 1 << bnUartOn );
+	U2STASET	= ( 1 << bnUartTxen );
+}
+
+/* ------------------------------------------------------------ */
+/***	FUartRoom
+**
+**	Synopsis:
+**		f = FUartRoom(cb)
+**
+**	Parameters:
+**		cb - frame length, before the CRC
+**
+**	Return Values:
+**		fTrue if FUartSendFrame would queue a frame of cb bytes now
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Checks the ring for the longest encoding of the frame: the
+**		CRC, a code byte per 254 bytes plus one, and the delimiter.
+**		The interrupt only ever adds room.
+*/
+
+BOOL FUartRoom(HWORD cb)
+{
+	HWORD	cbFree;
+
+	cbFree = ( ibUartTail - ibUartHead - 1 ) & ( cbUartRing - 1 );
+
+	return ( cb <= cbUartFrameMax ) && ( cbFree >= cb + 2 + ( ( cb + 2 ) / 254 ) + 2 );
+}
+
+/* ------------------------------------------------------------ */
+/***	FUartSendFrame
+**
+**	Synopsis:
+**		f = FUartSendFrame(pb, cb)
+**
+**	Parameters:
+**		pb - frame
+**		cb - its length, at most cbUartFrameMax
+**
+**	Return Values:
+**		fTrue if the frame was queued
+**
+**	Errors:
+**		drops the frame, and counts it in cFrameUartDrop, if it is
+**		too long or the ring has no room for it
+**
+**	Description:
+**		Appends the CRC, COBS encodes the frame with its zero
+**		delimiter into the ring and starts the transmit interrupt.
+**		Room is checked first (FUartRoom), so the frame is either
+**		queued whole or not at all.
+*/
+
+BOOL FUartSendFrame(const BYTE * pb, HWORD cb)
+{
+	HWORD	crc;
+	HWORD	ib;
+	HWORD	ibHead;
+	HWORD	ibCode;
+	BYTE	bCode;
+	BYTE	b;
+
+	if ( !FUartRoom(cb) ) {
+		cFrameUartDrop++;
+		return fFalse;
+	}
+
+	crc = CrcUart(pb, cb);
+
+	// Each code byte is written once its block is complete.
+	ibHead = ibUartHead;
+	ibCode = ibHead;
+	ibHead = IbUartNext(ibHead);
+	bCode = 1;
+	for ( ib = 0; ib < cb + 2; ib++ ) {
+		if ( ib < cb ) {
+			b = pb[ib];
+		}
+		else {
+			b = ( ib == cb ) ? (BYTE)crc : (BYTE)( crc >> 8 );
+		}
+
+		if ( b != 0 ) {
+			rgbUartRing[ibHead] = b;
+			ibHead = IbUartNext(ibHead);
+			bCode++;
+		}
+		if ( ( b == 0 ) || ( bCode == 0xFF ) ) {
+			rgbUartRing[ibCode] = bCode;
+			ibCode = ibHead;
+			ibHead = IbUartNext(ibHead);
+			bCode = 1;
+		}
+	}
+	rgbUartRing[ibCode] = bCode;
+	rgbUartRing[ibHead] = 0;
+	ibUartHead = IbUartNext(ibHead);
+
+	cFrameUartSent++;
+	IEC1SET = ( 1 << bnU2TxIf );
+
+	return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***	CrcUart
+**
+**	Synopsis:
+**		crc = CrcUart(pb, cb)
+**
+**	Parameters:
+**		pb - bytes
+**		cb - count
+**
+**	Return Values:
+**		CRC-16/CCITT-FALSE of the bytes
+**
+**	Errors:
+**		none
+*/
+
+HWORD CrcUart(const BYTE * pb, HWORD cb)
+{
+	HWORD	crc = crcUartInit;
+	BYTE	ibit;
+
+	while ( cb-- != 0 ) {
+		crc ^= (HWORD)( *pb++ ) << 8;
+		for ( ibit = 0; ibit < 8; ibit++ ) {
+			crc = ( crc & 0x8000 ) ? (HWORD)( ( crc << 1 ) ^ crcUartPoly ) : (HWORD)( crc << 1 );
+		}
+	}
+
+	return crc;
+}
+
+/************************************************************************/
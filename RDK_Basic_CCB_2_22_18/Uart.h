@@ -0,0 +1,82 @@
+/************************************************************************/
+/*																		*/
+/*	Uart.h	--  Framed UART Transmitter                                 */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for sending binary frames on      */
+/*  UART2 (U2TX, RF5) at baudUart, 8N1. A frame is queued with a        */
+/*  CRC-16 appended and is COBS encoded, so it contains no zero bytes,  */
+/*  and a zero byte ends it. A receiver that starts mid-stream or       */
+/*  loses a byte picks up again at the next zero.                       */
+/*																		*/
+/*  FUartSendFrame copies the encoded frame into a ring buffer and      */
+/*  returns; the UART interrupt, at the lowest priority, moves the      */
+/*  ring into the transmit FIFO. A frame that does not fit in the ring  */
+/*  is dropped whole and counted, so the caller never waits. Frames     */
+/*  must all be queued from one interrupt priority.                     */
+/*																		*/
+/*  The CRC is CRC-16/CCITT-FALSE (polynomial 0x1021, initial value     */
+/*  0xFFFF) over the frame, sent low byte first.                        */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_UART_INC)
+#define _UART_INC
+
+#include "config.h"
+#include "stdtypes.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Baud rate. With BRGH the divisor is frqPbClk / ( 4 baud ), exact
+**	at 500000 for the 8 MHz bus.
+*/
+#define	baudUart		500000
+#define	brgUart			( ( frqPbClk / ( 4 * baudUart ) ) - 1 )
+
+/*	Ring size, a power of two, and the longest frame FUartSendFrame
+**	takes before the CRC.
+*/
+#define	cbUartRing		512
+#define	cbUartFrameMax	250
+
+/*	UART2 interrupt bits: IFS1/IEC1 bit 10 is the transmit interrupt,
+**	and the priority is IPC8<4:0>.
+*/
+#define	bnU2TxIf		10
+#define	iplUart			1
+#define	ipsUart			3
+
+#define	crcUartInit		0xFFFF
+#define	crcUartPoly		0x1021
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	volatile WORD	cFrameUartSent;		// frames queued
+extern	volatile WORD	cFrameUartDrop;		// frames dropped, ring full
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+void	UartInit(void);
+BOOL	FUartRoom(HWORD cb);
+BOOL	FUartSendFrame(const BYTE * pb, HWORD cb);
+HWORD	CrcUart(const BYTE * pb, HWORD cb);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
@@ -182,6 +182,22 @@
 #define prtMtrRightDirClr	PORTDCLR
 #define	bnMtrRightDir		6
 
+/*	Motor encoder second hall outputs (SB). SA goes to IC2/IC3 on
+**	RD9/RD10; SB is on the next pin of the same JD connector. The
+**	stSbFwd value is the SB level seen on an SA rising edge while that
+**	wheel drives the robot forward; swap it if a wheel counts the
+**	wrong way.
+*/
+#define	trisMtrLeftSbSet	TRISCSET
+#define	prtMtrLeftSb		PORTC
+#define	bnMtrLeftSb			1
+#define	stMtrLeftSbFwd		0
+
+#define	trisMtrRightSbSet	TRISCSET
+#define	prtMtrRightSb		PORTC
+#define	bnMtrRightSb		2
+#define	stMtrRightSbFwd		1
+
 
 /* ------------------------------------------------------------ */
 /*					Miscellaneous Declarations					*/
@@ -189,6 +205,36 @@
 
 #define	OPT_HWSPI	2		//use SPI2 controller for SPI interface
 
+/*	Clock frequencies set by the configuration bits in main.c: 8 MHz
+**	crystal, PLL /2 x16 /1, peripheral bus divide by 8.
+*/
+#define	frqSysClk		64000000
+#define	frqPbClk		8000000
+
+#define	frqCtrlTick		43	//control tick rate in Hz (Timer 4)
+
+#define	OPT_ENCBENCH	0	//1 = time float vs fixed point speed math at startup
+
+#define	OPT_ENCFILT		3	//encoder glitch rejection: 0 = off, 1 = minimum
+							//interval, 2 = rate of change, 3 = median of 3
+
+#define	OPT_ENCPRE		1	//1 = capture every 4th/16th edge at high speed
+
+#define	OPT_TB32		0	//1 = 32-bit input capture on the cascaded Timer 2/3
+							//pair; PWM made by OC single pulses on that timer
+
+#define	OPT_PIDAW		2	//PID anti-windup: 0 = none, 1 = clamp integration,
+							//2 = back calculation
+
+#define	OPT_WHEELSYNC	1	//1 = cross-couple the wheel loops to hold the
+							//commanded speed ratio
+
+#define	OPT_TELEMUART	1	//1 = stream the telemetry records as COBS frames
+							//on UART2 (U2TX, RF5) for host/telemdec
+
+#define	OPT_TELEMSCOPE	1	//1 = record the loop telemetry as triggered scope
+							//captures instead of a continuous ring
+
 /* ------------------------------------------------------------ */
 /*					General Type Declarations					*/
 /* ------------------------------------------------------------ */
@@ -0,0 +1,179 @@
+/************************************************************************/
+/*																		*/
+/*	fixmath.c	--  Fixed Point Arithmetic                              */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This module contains definitions for the fixed point functions      */
+/*  that are too large to be macros: sine and cosine of a binary        */
+/*  angle, linearly interpolated from a 129 entry quarter wave table.   */
+/*  The worst case error is about one Q15 step.                         */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include "stdtypes.h"
+#include "fixmath.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	bnSinStep		23		// angle bits below one table step
+#define	cSinStep		128		// table steps per quarter turn
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+/*	sin(i * 90 / 128 degrees) in Q15, i = 0..128.
+*/
+static const HWORD rgsinQ15[cSinStep + 1] = {
+	    0,   402,   804,  1206,  1608,  2009,  2410,  2811,
+	 3212,  3612,  4011,  4410,  4808,  5205,  5602,  5998,
+	 6393,  6786,  7179,  7571,  7962,  8351,  8739,  9126,
+	 9512,  9896, 10278, 10659, 11039, 11417, 11793, 12167,
+	12539, 12910, 13279, 13645, 14010, 14372, 14732, 15090,
+	15446, 15800, 16151, 16499, 16846, 17189, 17530, 17869,
+	18204, 18537, 18868, 19195, 19519, 19841, 20159, 20475,
+	20787, 21096, 21403, 21705, 22005, 22301, 22594, 22884,
+	23170, 23452, 23731, 24007, 24279, 24547, 24811, 25072,
+	25329, 25582, 25832, 26077, 26319, 26556, 26790, 27019,
+	27245, 27466, 27683, 27896, 28105, 28310, 28510, 28706,
+	28898, 29085, 29268, 29447, 29621, 29791, 29956, 30117,
+	30273, 30424, 30571, 30714, 30852, 30985, 31113, 31237,
+	31356, 31470, 31580, 31685, 31785, 31880, 31971, 32057,
+	32137, 32213, 32285, 32351, 32412, 32469, 32521, 32567,
+	32609, 32646, 32678, 32705, 32728, 32745, 32757, 32765,
+	32767,
+};
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	SinQ15
+**
+**	Synopsis:
+**		sin = SinQ15(ang)
+**
+**	Parameters:
+**		ang - binary angle
+**
+**	Return Values:
+**		sine of ang in Q15, -32767 to 32767
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Folds the angle into the first quadrant, then interpolates
+**		between the two nearest table entries using the next 16 bits
+**		of the angle.
+*/
+
+int32_t SinQ15(WORD ang)
+{
+	WORD	angQ = ang & ( angQuarter - 1 );
+	WORD	i;
+	int32_t	q15;
+
+	if ( ang & angQuarter ) {
+		// second and fourth quadrants run the table backwards
+		angQ = angQuarter - angQ;
+	}
+
+	i = angQ >> bnSinStep;
+	if ( i >= cSinStep ) {
+		q15 = rgsinQ15[cSinStep];
+	}
+	else {
+		q15 = rgsinQ15[i] +
+			( ( ( rgsinQ15[i + 1] - rgsinQ15[i] ) *
+				(int32_t)( ( angQ >> ( bnSinStep - 16 ) ) & 0xFFFF ) ) >> 16 );
+	}
+
+	return ( ang & angHalf ) ? -q15 : q15;
+}
+
+/* ------------------------------------------------------------ */
+/***	CosQ15
+**
+**	Synopsis:
+**		cos = CosQ15(ang)
+**
+**	Parameters:
+**		ang - binary angle
+**
+**	Return Values:
+**		cosine of ang in Q15, -32767 to 32767
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		cos(a) = sin(a + 90 degrees).
+*/
+
+int32_t CosQ15(WORD ang)
+{
+	return SinQ15(ang + angQuarter);
+}
+
+/* ------------------------------------------------------------ */
+/***	Q16Sqrt
+**
+**	Synopsis:
+**		q = Q16Sqrt(q)
+**
+**	Parameters:
+**		q - value, Q16
+**
+**	Return Values:
+**		square root of q in Q16, rounded down; 0 for q <= 0
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Bitwise integer square root of q << 16: one result bit per
+**		step, shifts and adds only.
+*/
+
+Q16 Q16Sqrt(Q16 q)
+{
+	uint64_t	rem;
+	uint64_t	root = 0;
+	uint64_t	bit = (uint64_t)1 << 46;
+
+	if ( q <= 0 ) {
+		return 0;
+	}
+
+	rem = (uint64_t)q << bnQ16Frac;
+	while ( bit > rem ) {
+		bit >>= 2;
+	}
+	while ( bit != 0 ) {
+		if ( rem >= root + bit ) {
+			rem -= root + bit;
+			root = ( root >> 1 ) + bit;
+		}
+		else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (Q16)root;
+}
+
+/************************************************************************/
@@ -0,0 +1,86 @@
+/************************************************************************/
+/*																		*/
+/*	fixmath.h	--  Fixed Point Arithmetic Declarations                 */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header contains declarations for Q16.16 fixed point values.    */
+/*  The PIC32MX4 has no FPU, so any float arithmetic in an interrupt    */
+/*  service routine is done by the soft-float library. The M4K core     */
+/*  does have a single cycle multiplier and a hardware divider, so the  */
+/*  speed and control paths use these types instead.                    */
+/*																		*/
+/*  Angles are 32-bit binary angles: a full turn is 2^32, so they wrap  */
+/*  with ordinary unsigned arithmetic. SinQ15 and CosQ15 look them up   */
+/*  in a quarter wave table (fixmath.c).                                */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_FIXMATH_INC)
+#define _FIXMATH_INC
+
+#include "stdtypes.h"
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+/*	Q16.16 signed fixed point: 16 integer bits, 16 fraction bits.
+*/
+typedef	int32_t		Q16;
+
+#define	bnQ16Frac		16
+#define	q16One			((Q16)1 << bnQ16Frac)
+
+/*	Q1.15 signed fixed point, used for sine and cosine.
+*/
+#define	bnQ15Frac		15
+#define	q15One			32767
+
+/*	Binary angles: a right angle and a half turn.
+*/
+#define	angQuarter		0x40000000UL
+#define	angHalf			0x80000000UL
+
+/* ------------------------------------------------------------ */
+/*					        Macros		        				*/
+/* ------------------------------------------------------------ */
+
+/*	Conversions. Q16FromFloat is meant for compile time constants;
+**	FloatFromQ16 is for display and debugging, not for the fast path.
+*/
+#define	Q16FromInt(i)		((Q16)(i) << bnQ16Frac)
+#define	Q16FromFloat(f)		((Q16)((f) * 65536.0 + (((f) < 0) ? -0.5 : 0.5)))
+#define	IntFromQ16(q)		((q) >> bnQ16Frac)
+#define	FloatFromQ16(q)		((float)(q) / 65536.0f)
+
+/*	Multiply and divide with a 64-bit intermediate.
+*/
+#define	Q16Mul(a, b)		((Q16)(((int64_t)(a) * (b)) >> bnQ16Frac))
+#define	Q16Div(a, b)		((Q16)(((int64_t)(a) << bnQ16Frac) / (b)))
+
+/*	Binary angle conversions. AngFromDeg is meant for compile time
+**	constants; DegQ16FromAng gives a signed heading in (-180, 180].
+*/
+#define	AngFromDeg(d)		((WORD)(int64_t)((d) * (4294967296.0 / 360.0)))
+#define	DegQ16FromAng(a)	((Q16)(((int64_t)(int32_t)(a) * 360) >> bnQ16Frac))
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+int32_t	SinQ15(WORD ang);
+int32_t	CosQ15(WORD ang);
+Q16		Q16Sqrt(Q16 q);
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
@@ -0,0 +1,149 @@
+/************************************************************************/
+/*																		*/
+/*	ffwdsweep.c	--  Feedforward Table Build Test                        */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This host program runs the firmware's Ffwd.c characterization       */
+/*  sweep with made-up wheel speeds and checks the tables it builds.    */
+/*  The left wheel reads as moving on every step, step 0 included, as   */
+/*  a coasting wheel or one on a slope would; the right wheel does not  */
+/*  move until a few steps in. Both tables must have at most cFfwdPt    */
+/*  points, start at (0 ft/s, the highest duty that did not count as    */
+/*  moving) and be strictly increasing.                                 */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <stdio.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Pwm.h"
+#include "Ffwd.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	ctickSweepMax	100000
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	Q16		SpdSweep(Q16 dtc, Q16 spdOff);
+static	int		CErrTable(const char * szWheel, const struct ffwd * pffwd, Q16 dtc0);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	main
+**
+**	Synopsis:
+**		ffwdsweep
+**
+**	Return Values:
+**		0 if both tables are right, 1 if not
+*/
+
+int main(void)
+{
+	Q16		dtc = 0;
+	int		ctick;
+	int		cErr;
+
+	FfwdSweepStart();
+	for ( ctick = 0; ctick < ctickSweepMax; ctick++ ) {
+		if ( !FFfwdSweepTick(SpdSweep(dtc, Q16FromFloat(0.2)),
+							 SpdSweep(dtc, Q16FromFloat(-0.6)), &dtc) ) {
+			break;
+		}
+	}
+	if ( FFfwdSweeping() ) {
+		fprintf(stderr, "ffwdsweep: sweep did not end\n");
+		return 1;
+	}
+
+	// Left moves at duty 0, right first moves at the fourth step.
+	cErr = CErrTable("left", &ffwdLeft, 0);
+	cErr += CErrTable("right", &ffwdRight, Q16FromInt( ( 2 * dtcPwmMax ) / ( cFfwdPt - 1 ) ));
+
+	fprintf(stderr, "ffwdsweep: %d ticks, %u and %u points, %d errors\n",
+			ctick, (unsigned)ffwdLeft.cPt, (unsigned)ffwdRight.cPt, cErr);
+
+	return ( cErr != 0 ) ? 1 : 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	SpdSweep
+**
+**	Synopsis:
+**		spd = SpdSweep(dtc, spdOff)
+**
+**	Parameters:
+**		dtc    - duty cycle the wheel is driven at, Q16
+**		spdOff - speed at duty 0, ft/s; negative for a dead band
+**
+**	Return Values:
+**		wheel speed, ft/s: 3 ft/s at full duty plus spdOff, never
+**		below 0
+*/
+
+static Q16 SpdSweep(Q16 dtc, Q16 spdOff)
+{
+	Q16		spd = (Q16)( ( (int64_t)dtc * 3 ) / dtcPwmMax ) + spdOff;
+
+	return ( spd > 0 ) ? spd : 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	CErrTable
+**
+**	Synopsis:
+**		cErr = CErrTable(szWheel, pffwd, dtc0)
+**
+**	Parameters:
+**		szWheel - wheel name, for the report
+**		pffwd   - table built by the sweep
+**		dtc0    - duty expected at point 0
+**
+**	Return Values:
+**		number of problems found
+*/
+
+static int CErrTable(const char * szWheel, const struct ffwd * pffwd, Q16 dtc0)
+{
+	WORD	ipt;
+	int		cErr = 0;
+
+	if ( ( pffwd->cPt < 2 ) || ( pffwd->cPt > cFfwdPt ) ) {
+		fprintf(stderr, "ffwdsweep: %s: %u points\n", szWheel, (unsigned)pffwd->cPt);
+		return 1;
+	}
+	if ( ( pffwd->rgspd[0] != 0 ) || ( pffwd->rgdtc[0] != dtc0 ) ) {
+		fprintf(stderr, "ffwdsweep: %s: point 0 is (%d, %d)\n", szWheel,
+				(int)pffwd->rgspd[0], (int)pffwd->rgdtc[0]);
+		cErr++;
+	}
+	for ( ipt = 1; ipt < pffwd->cPt; ipt++ ) {
+		if ( ( pffwd->rgspd[ipt] <= pffwd->rgspd[ipt - 1] ) ||
+			 ( pffwd->rgdtc[ipt] <= pffwd->rgdtc[ipt - 1] ) ) {
+			fprintf(stderr, "ffwdsweep: %s: point %u does not increase\n", szWheel, (unsigned)ipt);
+			cErr++;
+		}
+	}
+
+	return cErr;
+}
+
+/************************************************************************/
@@ -0,0 +1,352 @@
+/************************************************************************/
+/*																		*/
+/*	loopback.c	--  Telemetry Stream Loopback Test                      */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This host program runs the firmware's Telem.c and Uart.c against    */
+/*  stub registers (stub/plib.h) and writes the bytes the UART would    */
+/*  send to stdout, for telemdec to decode. It stands in for the robot  */
+/*  and a serial cable; see the Makefile check target.                  */
+/*																		*/
+/*  The run is ctickLoop control ticks of three channels in scope mode, */
+/*  streaming. Each tick takes a record and then empties the ring into  */
+/*  the UART, a byte at a time through the interrupt handler, as the    */
+/*  500000 baud line would well within a tick, except for a stall of    */
+/*  a few ticks while the first capture is being sent. Triggers come    */
+/*  before the pre-trigger records are in and during a capture, which   */
+/*  must be ignored, and twice when armed, which must give captures 1   */
+/*  and 2.                                                              */
+/*																		*/
+/*  With -x it writes instead the CSV telemdec should make of the       */
+/*  records, and with -c n the CSV it should write for capture n.       */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <plib.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Uart.h"
+#include "Telem.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	ctickLoop		400
+#define	tusLoopTick		23255
+#define	crecLoopPre		20
+#define	crecLoopPost	40
+#define	cchLoop			3
+
+#define	itickStallFirst	100		// ticks the UART does not run
+#define	itickStallLast	102
+
+#define	bnTxbf			9		// U2STA transmit FIFO full
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+volatile unsigned int	U2MODE;
+volatile unsigned int	U2MODESET;
+volatile unsigned int	U2STASET;
+volatile unsigned int	U2BRG;
+volatile unsigned int	U2TXREG = txLoopEmpty;
+volatile unsigned int	IFS1CLR;
+volatile unsigned int	IEC1SET;
+volatile unsigned int	IEC1CLR;
+volatile unsigned int	IPC8SET;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+static	volatile unsigned int	u2sta;
+
+static	Q16		qLoopSpd;
+static	Q16		qLoopDtc;
+static	Q16		qLoopRaw;
+
+static const struct telemch	rgchLoop[cchLoop] = {
+	{ &qLoopSpd,	bnTelemSpd },
+	{ &qLoopDtc,	bnTelemDtc },
+	{ &qLoopRaw,	0 },
+};
+
+/*	Trigger ticks and what each should do.
+*/
+static const struct {
+	int		itick;
+	BYTE	fbSrc;
+	int		icap;			// capture it starts, 0 if ignored
+} rgtrigLoop[] = {
+	{ 5,	0x04,	0 },	// pre-trigger records not in yet
+	{ 50,	0x04,	1 },
+	{ 70,	0x01,	0 },	// capture 1 still being taken
+	{ 250,	0x02,	2 },
+};
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+void			Uart2Handler(void);
+
+static	void	LoopSet(int itick);
+static	void	LoopDrain(void);
+static	void	LoopPrintRec(int itick);
+static	int		LoopRun(void);
+static	int		LoopExpectLive(void);
+static	int		LoopExpectCap(int icap);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	main
+**
+**	Synopsis:
+**		loopback [-x | -c n]
+**
+**	Return Values:
+**		0 on success, 1 on a usage error or if a frame was dropped
+*/
+
+int main(int argc, char * argv[])
+{
+	if ( argc == 1 ) {
+		return LoopRun();
+	}
+	if ( ( argc == 2 ) && ( strcmp(argv[1], "-x") == 0 ) ) {
+		return LoopExpectLive();
+	}
+	if ( ( argc == 3 ) && ( strcmp(argv[1], "-c") == 0 ) ) {
+		return LoopExpectCap(atoi(argv[2]));
+	}
+
+	fprintf(stderr, "usage: loopback [-x | -c n]\n");
+	return 1;
+}
+
+/* ------------------------------------------------------------ */
+/***	LoopU2Sta
+**
+**	Synopsis:
+**		pu = LoopU2Sta()
+**
+**	Return Values:
+**		U2STA, with the FIFO full bit set while U2TXREG holds a byte
+*/
+
+volatile unsigned int * LoopU2Sta(void)
+{
+	if ( U2TXREG != txLoopEmpty ) {
+		u2sta |= ( 1 << bnTxbf );
+	}
+	else {
+		u2sta &= ~( 1 << bnTxbf );
+	}
+
+	return &u2sta;
+}
+
+/* ------------------------------------------------------------ */
+/***	LoopRun
+**
+**	Synopsis:
+**		err = LoopRun()
+**
+**	Return Values:
+**		0, or 1 if the UART dropped a frame
+**
+**	Description:
+**		Runs the ticks and writes the UART output to stdout.
+*/
+
+static int LoopRun(void)
+{
+	int		itick;
+	int		itrig = 0;
+	int		ctrig = sizeof(rgtrigLoop) / sizeof(rgtrigLoop[0]);
+
+	UartInit();
+	if ( !FTelemConfig(rgchLoop, cchLoop, 0, modeTelemRing) ||
+		 !FTelemScope(crecLoopPre, crecLoopPost) ) {
+		fprintf(stderr, "loopback: recorder setup failed\n");
+		return 1;
+	}
+	TelemStream(fTrue);
+
+	for ( itick = 0; itick < ctickLoop; itick++ ) {
+		LoopSet(itick);
+		if ( ( itrig < ctrig ) && ( rgtrigLoop[itrig].itick == itick ) ) {
+			TelemTrigger(rgtrigLoop[itrig++].fbSrc);
+		}
+		TelemRecord((WORD)itick * tusLoopTick);
+
+		if ( ( itick < itickStallFirst ) || ( itick > itickStallLast ) ) {
+			LoopDrain();
+		}
+	}
+	LoopDrain();
+	fflush(stdout);
+
+	fprintf(stderr, "loopback: %u frames sent, %u dropped, %u captures\n",
+			cFrameUartSent, cFrameUartDrop, telem.icap);
+
+	return ( cFrameUartDrop != 0 ) ? 1 : 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	LoopSet
+**
+**	Synopsis:
+**		LoopSet(itick)
+**
+**	Parameters:
+**		itick - tick number
+**
+**	Description:
+**		Sets the channel variables for a tick: ramps of about
+**		0.01 ft/s, 30 duty counts and 7 Q16 counts per tick.
+*/
+
+static void LoopSet(int itick)
+{
+	qLoopSpd = itick * 655 - q16One;
+	qLoopDtc = Q16FromInt(itick * 30 - 4000);
+	qLoopRaw = itick * 7 - 1000;
+}
+
+/* ------------------------------------------------------------ */
+/***	LoopDrain
+**
+**	Synopsis:
+**		LoopDrain()
+**
+**	Description:
+**		Runs the UART interrupt until the ring is empty, sending
+**		each byte it puts in the FIFO to stdout.
+*/
+
+static void LoopDrain(void)
+{
+	for (;;) {
+		Uart2Handler();
+		if ( U2TXREG == txLoopEmpty ) {
+			break;
+		}
+		putchar((int)( U2TXREG & 0xFF ));
+		U2TXREG = txLoopEmpty;
+	}
+}
+
+/* ------------------------------------------------------------ */
+/***	LoopPrintRec
+**
+**	Synopsis:
+**		LoopPrintRec(itick)
+**
+**	Parameters:
+**		itick - tick number
+**
+**	Description:
+**		Writes the channels of a tick as telemdec scales them.
+*/
+
+static void LoopPrintRec(int itick)
+{
+	int		ich;
+	int16_t	s;
+
+	LoopSet(itick);
+	for ( ich = 0; ich < cchLoop; ich++ ) {
+		s = (int16_t)( *rgchLoop[ich].pq >> rgchLoop[ich].bnShift );
+		printf(",%.6g", (double)s * (double)( 1UL << rgchLoop[ich].bnShift ) / 65536.0);
+	}
+	printf("\n");
+}
+
+/* ------------------------------------------------------------ */
+/***	LoopExpectLive
+**
+**	Synopsis:
+**		err = LoopExpectLive()
+**
+**	Description:
+**		Writes the record CSV telemdec should produce: every tick,
+**		sequence numbers from 1.
+*/
+
+static int LoopExpectLive(void)
+{
+	int		itick;
+
+	printf("seq,tus,ch0,ch1,ch2\n");
+	for ( itick = 0; itick < ctickLoop; itick++ ) {
+		printf("%d,%lu", itick + 1, (unsigned long)itick * tusLoopTick);
+		LoopPrintRec(itick);
+	}
+
+	return 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	LoopExpectCap
+**
+**	Synopsis:
+**		err = LoopExpectCap(icap)
+**
+**	Parameters:
+**		icap - capture number
+**
+**	Return Values:
+**		0, or 1 if there is no such capture
+**
+**	Description:
+**		Writes the CSV telemdec should write for a capture: the
+**		records from crecLoopPre ticks before its trigger to
+**		crecLoopPost - 1 after, numbered from the trigger.
+*/
+
+static int LoopExpectCap(int icap)
+{
+	int		itrig;
+	int		itick;
+	int		n;
+
+	for ( itrig = 0; itrig < (int)( sizeof(rgtrigLoop) / sizeof(rgtrigLoop[0]) ); itrig++ ) {
+		if ( rgtrigLoop[itrig].icap == icap ) {
+			break;
+		}
+	}
+	if ( ( icap == 0 ) || ( itrig == (int)( sizeof(rgtrigLoop) / sizeof(rgtrigLoop[0]) ) ) ) {
+		fprintf(stderr, "loopback: no capture %d\n", icap);
+		return 1;
+	}
+
+	printf("n,ch0,ch1,ch2\n");
+	for ( n = -crecLoopPre; n < crecLoopPost; n++ ) {
+		itick = rgtrigLoop[itrig].itick + n;
+		printf("%d", n);
+		LoopPrintRec(itick);
+	}
+
+	return 0;
+}
+
+/************************************************************************/
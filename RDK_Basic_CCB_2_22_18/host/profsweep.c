@@ -0,0 +1,123 @@
+/************************************************************************/
+/*																		*/
+/*	profsweep.c	--  Velocity Profile Overshoot Test                     */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This host program runs the firmware's Profile.c with the wheel      */
+/*  limits (accProfWheel, jerkProfWheel) at the control tick of         */
+/*  Control.h and checks that the shaped setpoint never passes its      */
+/*  target. For cspdSweep start speeds up to spdSweepMax it ramps from  */
+/*  the start to zero and back up from zero to the start, as an         */
+/*  S-curve and as a trapezoid, and checks that every ramp ends on the  */
+/*  target with no acceleration left.                                   */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <stdio.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "fixmath.h"
+#include "Control.h"
+#include "Profile.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	cspdSweep		300
+#define	spdSweepMax		Q16FromFloat(3.0)
+#define	ctickRampMax	10000
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	int		CErrRamp(Q16 jerk, Q16 spdFrom, Q16 spdTo);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	main
+**
+**	Synopsis:
+**		profsweep
+**
+**	Return Values:
+**		0 if no ramp passed its target, 1 if any did
+*/
+
+int main(void)
+{
+	int		ispd;
+	Q16		spd;
+	int		cErr = 0;
+
+	for ( ispd = 1; ispd <= cspdSweep; ispd++ ) {
+		spd = (Q16)( ( (int64_t)spdSweepMax * ispd ) / cspdSweep );
+		cErr += CErrRamp(jerkProfWheel, spd, 0);
+		cErr += CErrRamp(jerkProfWheel, 0, spd);
+		cErr += CErrRamp(jerkProfWheel, -spd, 0);
+		cErr += CErrRamp(0, spd, 0);
+	}
+
+	fprintf(stderr, "profsweep: %d ramps at %u us ticks, %d wrong\n",
+			4 * cspdSweep, (unsigned)tusCtrlTick, cErr);
+
+	return ( cErr != 0 ) ? 1 : 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	CErrRamp
+**
+**	Synopsis:
+**		cErr = CErrRamp(jerk, spdFrom, spdTo)
+**
+**	Parameters:
+**		jerk    - jerk limit, ft/s^3; 0 for a trapezoid
+**		spdFrom - speed to start at, ft/s
+**		spdTo   - target, ft/s
+**
+**	Return Values:
+**		1 if the setpoint passed the target or did not settle on it,
+**		else 0
+*/
+
+static int CErrRamp(Q16 jerk, Q16 spdFrom, Q16 spdTo)
+{
+	struct prof	prof;
+	Q16			spd;
+	int			ctick;
+
+	ProfInit(&prof, accProfWheel, jerk, tusCtrlTick);
+	ProfReset(&prof, spdFrom);
+
+	for ( ctick = 0; ctick < ctickRampMax; ctick++ ) {
+		spd = ProfTick(&prof, spdTo);
+		if ( ( spdTo > spdFrom ) ? ( spd > spdTo ) : ( spd < spdTo ) ) {
+			fprintf(stderr, "profsweep: %.6f to %.6f, jerk %.1f: %.6f at tick %d\n",
+					spdFrom / 65536.0, spdTo / 65536.0, jerk / 65536.0,
+					spd / 65536.0, ctick);
+			return 1;
+		}
+		if ( ( spd == spdTo ) && ( prof.accQ24 == 0 ) ) {
+			return 0;
+		}
+	}
+
+	fprintf(stderr, "profsweep: %.6f to %.6f, jerk %.1f: did not settle\n",
+			spdFrom / 65536.0, spdTo / 65536.0, jerk / 65536.0);
+	return 1;
+}
+
+/************************************************************************/
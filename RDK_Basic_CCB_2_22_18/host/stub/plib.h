@@ -0,0 +1,98 @@
+/************************************************************************/
+/*																		*/
+/*	plib.h	--  Host Stand-in for the PIC32 Peripheral Library           */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This header lets Uart.c and Telem.c build on the host for the       */
+/*  loopback test (loopback.c). It declares the registers those two     */
+/*  modules touch as plain variables, defined in loopback.c, and makes  */
+/*  the interrupt calls do nothing; the test calls the UART handler     */
+/*  itself. U2STA is read through LoopU2Sta so the transmit FIFO full   */
+/*  bit follows U2TXREG, a one byte FIFO that loopback.c empties.       */
+/*																		*/
+/*  Timebase.c builds against it for the timebase race test (tbrace.c)  */
+/*  with STUB_INTHOOK defined. Then the interrupt calls are defined in  */
+/*  tbrace.c, and IFS0CLR is written through TbStubIfs0Clr, which       */
+/*  clears the Timer 3 flag and is where a higher priority interrupt    */
+/*  can come in.                                                        */
+/*																		*/
+/*  It is not the Microchip header and is not used for the firmware.    */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+#if !defined(_PLIB_STUB_INC)
+#define _PLIB_STUB_INC
+
+/* ------------------------------------------------------------ */
+/*					General Type Declarations					*/
+/* ------------------------------------------------------------ */
+
+#define	__ISR(vec, ipl)
+#define	_UART_2_VECTOR		32
+#define	_TIMER_3_VECTOR		12
+
+/*	U2TXREG holds this while the FIFO is empty.
+*/
+#define	txLoopEmpty			0xFFFFFFFFu
+
+#define	U2STA				(*LoopU2Sta())
+#define	IFS0CLR				(*TbStubIfs0Clr())
+
+/* ------------------------------------------------------------ */
+/*					Variable Declarations						*/
+/* ------------------------------------------------------------ */
+
+extern	volatile unsigned int	U2MODE;
+extern	volatile unsigned int	U2MODESET;
+extern	volatile unsigned int	U2STASET;
+extern	volatile unsigned int	U2BRG;
+extern	volatile unsigned int	U2TXREG;
+extern	volatile unsigned int	IFS1CLR;
+extern	volatile unsigned int	IEC1SET;
+extern	volatile unsigned int	IEC1CLR;
+extern	volatile unsigned int	IPC8SET;
+
+extern	volatile unsigned int	T2CON;
+extern	volatile unsigned int	T3CON;
+extern	volatile unsigned int	TMR2;
+extern	volatile unsigned int	TMR3;
+extern	volatile unsigned int	PR2;
+extern	volatile unsigned int	PR3;
+extern	volatile unsigned int	IFS0;
+extern	volatile unsigned int	IEC0SET;
+extern	volatile unsigned int	IPC3SET;
+
+/* ------------------------------------------------------------ */
+/*					Procedure Declarations						*/
+/* ------------------------------------------------------------ */
+
+volatile unsigned int *	LoopU2Sta(void);
+volatile unsigned int *	TbStubIfs0Clr(void);
+
+#if defined(STUB_INTHOOK)
+unsigned int	INTDisableInterrupts(void);
+void			INTRestoreInterrupts(unsigned int st);
+#else
+static inline unsigned int INTDisableInterrupts(void)
+{
+	return 0;
+}
+
+static inline void INTRestoreInterrupts(unsigned int st)
+{
+	(void)st;
+}
+#endif
+
+/* ------------------------------------------------------------ */
+
+#endif
+
+/************************************************************************/
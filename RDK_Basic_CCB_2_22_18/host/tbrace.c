@@ -0,0 +1,239 @@
+/************************************************************************/
+/*																		*/
+/*	tbrace.c	--  Timebase Overflow Race Test                         */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This host program runs the firmware's Timebase.c against stub       */
+/*  registers (stub/plib.h) and checks that a capture ISR, which runs   */
+/*  above Timer3Handler, extends its timestamps right wherever it comes */
+/*  in around a Timer 3 wrap.                                           */
+/*																		*/
+/*  For each of cperRace periods the timer wraps with the interrupt     */
+/*  pending, and the capture ISR runs three times: before the handler,  */
+/*  at the point in the handler where the flag is cleared (or, if the   */
+/*  handler has interrupts disabled there, as soon as it enables them), */
+/*  and after it. Captures alternate between a value taken just before  */
+/*  the wrap and one just after.                                        */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <stdio.h>
+#include <plib.h>
+#include "config.h"
+#include "stdtypes.h"
+#include "Timebase.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+#define	cperRace		100
+#define	tckRaceAfter	1		// capture just after the wrap
+#define	tckRaceNow		3		// timer value while the ISRs run
+
+#define	bnT3If			12
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+volatile unsigned int	T2CON;
+volatile unsigned int	T3CON;
+volatile unsigned int	TMR2;
+volatile unsigned int	TMR3;
+volatile unsigned int	PR2;
+volatile unsigned int	PR3;
+volatile unsigned int	IFS0;
+volatile unsigned int	IEC0SET;
+volatile unsigned int	IPC3SET;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+static	unsigned int	fIntOff;
+static	BOOL			fIsrPend;		// capture ISR held off by fIntOff
+static	BOOL			fIsrArm;		// run the ISR when IFS0CLR is written
+
+static	volatile unsigned int	ifs0clr;
+
+static	HWORD	tckCap;
+static	DWORD	tusCapExp;
+static	DWORD	tusNowExp;
+static	int		cIsr;
+static	int		cWrong;
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+void			Timer3Handler(void);
+
+static	void	RaceIsr(const char * szWhere);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	main
+**
+**	Synopsis:
+**		tbrace
+**
+**	Return Values:
+**		0 if every timestamp was right, 1 if not
+*/
+
+int main(void)
+{
+	int		iper;
+
+	TbInit();
+
+	for ( iper = 1; iper <= cperRace; iper++ ) {
+		TMR3 = tckRaceNow;
+		IFS0 |= ( 1 << bnT3If );
+
+		if ( iper & 1 ) {
+			tckCap		= tckRaceAfter;
+			tusCapExp	= ( (DWORD)iper * tusTbPeriod ) + tckRaceAfter;
+		}
+		else {
+			tckCap		= tusTbPeriod - 1;
+			tusCapExp	= ( (DWORD)iper * tusTbPeriod ) - 1;
+		}
+		tusNowExp = ( (DWORD)iper * tusTbPeriod ) + tckRaceNow;
+
+		RaceIsr("before the handler");
+
+		fIsrArm = fTrue;
+		Timer3Handler();
+		if ( fIsrArm || fIsrPend ) {
+			fprintf(stderr, "tbrace: handler did not clear the flag\n");
+			return 1;
+		}
+
+		RaceIsr("after the handler");
+	}
+
+	fprintf(stderr, "tbrace: %d overflows, %d captures, %d wrong\n",
+			cperRace, cIsr, cWrong);
+
+	return ( ( cWrong != 0 ) || ( cIsr != 3 * cperRace ) ) ? 1 : 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	TbStubIfs0Clr
+**
+**	Synopsis:
+**		IFS0CLR = fb
+**
+**	Return Values:
+**		pointer to a register that takes the write
+**
+**	Description:
+**		Timebase.c only clears the Timer 3 flag, so this clears it
+**		first, then lets the capture ISR in if it is armed: at once
+**		if interrupts are enabled, when they are enabled again if not.
+*/
+
+volatile unsigned int * TbStubIfs0Clr(void)
+{
+	IFS0 &= ~( 1 << bnT3If );
+
+	if ( fIsrArm ) {
+		fIsrArm = fFalse;
+		if ( fIntOff ) {
+			fIsrPend = fTrue;
+		}
+		else {
+			RaceIsr("in the handler");
+		}
+	}
+
+	return &ifs0clr;
+}
+
+/* ------------------------------------------------------------ */
+/***	INTDisableInterrupts
+**
+**	Synopsis:
+**		st = INTDisableInterrupts()
+**
+**	Return Values:
+**		the previous interrupt state, for INTRestoreInterrupts
+*/
+
+unsigned int INTDisableInterrupts(void)
+{
+	unsigned int	st = fIntOff;
+
+	fIntOff = 1;
+	return st;
+}
+
+/* ------------------------------------------------------------ */
+/***	INTRestoreInterrupts
+**
+**	Synopsis:
+**		INTRestoreInterrupts(st)
+**
+**	Parameters:
+**		st - state from INTDisableInterrupts
+**
+**	Description:
+**		Restores the state, and runs a capture ISR that was held off
+**		once interrupts are enabled.
+*/
+
+void INTRestoreInterrupts(unsigned int st)
+{
+	fIntOff = st;
+	if ( !fIntOff && fIsrPend ) {
+		fIsrPend = fFalse;
+		RaceIsr("after interrupts came back on");
+	}
+}
+
+/* ------------------------------------------------------------ */
+/***	RaceIsr
+**
+**	Synopsis:
+**		RaceIsr(szWhere)
+**
+**	Parameters:
+**		szWhere - where in the handler it ran, for the report
+**
+**	Description:
+**		Stands in for the capture ISR: extends tckCap and reads the
+**		clock, and checks both against the expected times.
+*/
+
+static void RaceIsr(const char * szWhere)
+{
+	DWORD	tusCap;
+	DWORD	tusNow;
+
+	cIsr++;
+	tusCap = TbCaptureUs(tckCap);
+	tusNow = TbNowUs();
+
+	if ( ( tusCap != tusCapExp ) || ( tusNow != tusNowExp ) ) {
+		cWrong++;
+		fprintf(stderr, "tbrace: %s: capture %llu, expected %llu; now %llu, expected %llu\n",
+				szWhere, (unsigned long long)tusCap, (unsigned long long)tusCapExp,
+				(unsigned long long)tusNow, (unsigned long long)tusNowExp);
+	}
+}
+
+/************************************************************************/
@@ -0,0 +1,639 @@
+/************************************************************************/
+/*																		*/
+/*	telemdec.c	--  Telemetry Stream Decoder                            */
+/*																		*/
+/************************************************************************/
+/*  File Description:													*/
+/*																		*/
+/*  This is a host program, for Linux, that reads the telemetry stream  */
+/*  the robot sends on UART2 (Telem.h, Uart.h) and writes it to stdout  */
+/*  as CSV, one line per record: the sequence number, the tick time in  */
+/*  microseconds and the channels. Frames with a bad CRC, records lost  */
+/*  on the robot or on the line, and a summary at the end go to stderr. */
+/*																		*/
+/*  The samples are scaled back to their Q16 values as floating point,  */
+/*  using the shifts from the latest channel frame; records that come   */
+/*  before the first channel frame are skipped. With -r the samples are */
+/*  written raw and nothing is skipped.                                 */
+/*																		*/
+/*  Scope captures (Telem.h, OPT_TELEMSCOPE) come as capture frames     */
+/*  between the records. With -c each one is written to its own file,   */
+/*  prefix-NNN.csv, where the first column is the record number counted */
+/*  from the trigger record, so the pre-trigger records are negative.   */
+/*  Without -c they are counted and dropped.                            */
+/*																		*/
+/*  Build:  cc -O2 -o telemdec telemdec.c                               */
+/*  Test:   make check, in this directory: loopback.c runs the          */
+/*          firmware's Telem.c and Uart.c against stub registers        */
+/*          and pipes the UART bytes into telemdec, then compares       */
+/*          the CSV and the captures with what they should be.          */
+/*  Use:    telemdec [-r] [-c prefix] /dev/ttyUSB0 > run.csv            */
+/*																		*/
+/*  The device is set to raw 500000 baud if it is a terminal. Any other */
+/*  file, or - for stdin, is read as it is, for a saved capture.        */
+/*																		*/
+/************************************************************************/
+/*  Revision History:													*/
+/*																		*/
+/*  10/16/26: created                                                   */
+/*																		*/
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*				Include File Definitions						*/
+/* ------------------------------------------------------------ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions							*/
+/* ------------------------------------------------------------ */
+
+/*	These must match Telem.h and Uart.h.
+*/
+#define	ftypTelemRec	1
+#define	ftypTelemChan	2
+#define	ftypTelemCap	3
+#define	cbTelemRecHdr	8
+#define	cbTelemCapHdr	10
+#define	cchTelemMax		8
+
+#define	crcUartInit		0xFFFF
+#define	crcUartPoly		0x1021
+
+/*	Longest encoded frame kept; anything longer is line noise.
+*/
+#define	cbFrameMax		512
+
+struct dec {
+	int			fRaw;
+	const char *	szCapPrefix;
+	FILE *		pfileCap;			// capture being written
+	unsigned	icap;
+	unsigned	irecCapNext;
+	int			fChan;				// a channel frame has been seen
+	int			cch;
+	int			rgbnShift[cchTelemMax];
+	int			fSeq;				// a record has been seen
+	unsigned	seqLast;
+	unsigned long	cFrame;
+	unsigned long	cRec;
+	unsigned long	cCrcErr;
+	unsigned long	cBadFrame;
+	unsigned long	cRecLost;
+	unsigned long	cRecSkip;
+	unsigned long	cCap;
+};
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+static	int			FdOpen(const char * szDev);
+static	int			CbCobsDecode(const uint8_t * pbIn, int cbIn, uint8_t * pbOut);
+static	uint16_t	CrcFrame(const uint8_t * pb, int cb);
+static	void		DecFrame(struct dec * pdec, const uint8_t * pb, int cb);
+static	void		DecChan(struct dec * pdec, const uint8_t * pb, int cb);
+static	void		DecRec(struct dec * pdec, const uint8_t * pb, int cb);
+static	void		DecCap(struct dec * pdec, const uint8_t * pb, int cb);
+static	void		PrintSample(FILE * pfile, struct dec * pdec, int ich, const uint8_t * pb);
+
+/* ------------------------------------------------------------ */
+/*				Procedure Definitions							*/
+/* ------------------------------------------------------------ */
+/***	main
+**
+**	Synopsis:
+**		telemdec [-r] [-c prefix] device
+**
+**	Return Values:
+**		0 at the end of the input, 1 on a usage or open error
+**
+**	Description:
+**		Splits the input at zero bytes and decodes each frame.
+*/
+
+int main(int argc, char * argv[])
+{
+	struct dec	dec;
+	uint8_t		rgbIn[4096];
+	uint8_t		rgbEnc[cbFrameMax];
+	uint8_t		rgbFrame[cbFrameMax];
+	int			cbEnc = 0;
+	int			fOverrun = 0;
+	int			fd;
+	int			iarg = 1;
+	ssize_t		cbRead;
+	ssize_t		ib;
+	int			cb;
+
+	memset(&dec, 0, sizeof(dec));
+	for ( ; ( iarg < argc ) && ( argv[iarg][0] == '-' ) && ( argv[iarg][1] != 0 ); iarg++ ) {
+		if ( strcmp(argv[iarg], "-r") == 0 ) {
+			dec.fRaw = 1;
+		}
+		else if ( ( strcmp(argv[iarg], "-c") == 0 ) && ( iarg + 1 < argc ) ) {
+			dec.szCapPrefix = argv[++iarg];
+		}
+		else {
+			break;
+		}
+	}
+	if ( iarg != argc - 1 ) {
+		fprintf(stderr, "usage: telemdec [-r] [-c prefix] device\n");
+		return 1;
+	}
+
+	fd = FdOpen(argv[iarg]);
+	if ( fd < 0 ) {
+		return 1;
+	}
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	for (;;) {
+		cbRead = read(fd, rgbIn, sizeof(rgbIn));
+		if ( cbRead < 0 ) {
+			if ( errno == EINTR ) {
+				continue;
+			}
+			// A pty reads EIO once the other side closes.
+			if ( errno != EIO ) {
+				perror("telemdec: read");
+			}
+			break;
+		}
+		if ( cbRead == 0 ) {
+			break;
+		}
+
+		for ( ib = 0; ib < cbRead; ib++ ) {
+			if ( rgbIn[ib] != 0 ) {
+				if ( cbEnc < cbFrameMax ) {
+					rgbEnc[cbEnc++] = rgbIn[ib];
+				}
+				else {
+					fOverrun = 1;
+				}
+				continue;
+			}
+
+			if ( fOverrun ) {
+				dec.cBadFrame++;
+			}
+			else if ( cbEnc != 0 ) {
+				cb = CbCobsDecode(rgbEnc, cbEnc, rgbFrame);
+				if ( cb < 0 ) {
+					dec.cBadFrame++;
+				}
+				else {
+					DecFrame(&dec, rgbFrame, cb);
+				}
+			}
+			cbEnc = 0;
+			fOverrun = 0;
+		}
+	}
+
+	if ( dec.pfileCap != NULL ) {
+		fprintf(stderr, "telemdec: capture %u cut short\n", dec.icap);
+		fclose(dec.pfileCap);
+	}
+	fprintf(stderr, "telemdec: %lu frames, %lu records, %lu lost, %lu skipped, "
+			"%lu captures, %lu CRC errors, %lu bad frames\n",
+			dec.cFrame, dec.cRec, dec.cRecLost, dec.cRecSkip,
+			dec.cCap, dec.cCrcErr, dec.cBadFrame);
+
+	return 0;
+}
+
+/* ------------------------------------------------------------ */
+/***	FdOpen
+**
+**	Synopsis:
+**		fd = FdOpen(szDev)
+**
+**	Parameters:
+**		szDev - device or file name, - for stdin
+**
+**	Return Values:
+**		file descriptor, -1 on error
+**
+**	Errors:
+**		reports the error on stderr
+**
+**	Description:
+**		Opens the input and sets a terminal to raw 500000 baud.
+*/
+
+static int FdOpen(const char * szDev)
+{
+	struct termios	tio;
+	int				fd;
+
+	if ( strcmp(szDev, "-") == 0 ) {
+		return 0;
+	}
+
+	fd = open(szDev, O_RDONLY | O_NOCTTY);
+	if ( fd < 0 ) {
+		fprintf(stderr, "telemdec: %s: %s\n", szDev, strerror(errno));
+		return -1;
+	}
+	if ( !isatty(fd) ) {
+		return fd;
+	}
+
+	if ( tcgetattr(fd, &tio) != 0 ) {
+		fprintf(stderr, "telemdec: %s: %s\n", szDev, strerror(errno));
+		close(fd);
+		return -1;
+	}
+	cfmakeraw(&tio);
+	tio.c_cflag |= CLOCAL | CREAD;
+	tio.c_cc[VMIN]	= 1;
+	tio.c_cc[VTIME]	= 0;
+	cfsetispeed(&tio, B500000);
+	cfsetospeed(&tio, B500000);
+	if ( tcsetattr(fd, TCSANOW, &tio) != 0 ) {
+		fprintf(stderr, "telemdec: %s: %s\n", szDev, strerror(errno));
+		close(fd);
+		return -1;
+	}
+	tcflush(fd, TCIFLUSH);
+
+	return fd;
+}
+
+/* ------------------------------------------------------------ */
+/***	CbCobsDecode
+**
+**	Synopsis:
+**		cb = CbCobsDecode(pbIn, cbIn, pbOut)
+**
+**	Parameters:
+**		pbIn  - encoded frame, without its zero delimiter
+**		cbIn  - its length
+**		pbOut - receives the decoded frame, at most cbIn bytes
+**
+**	Return Values:
+**		decoded length, -1 if the encoding is broken
+**
+**	Errors:
+**		a code byte that runs past the end of the frame
+**
+**	Description:
+**		Undoes the COBS encoding of FUartSendFrame.
+*/
+
+static int CbCobsDecode(const uint8_t * pbIn, int cbIn, uint8_t * pbOut)
+{
+	int		ibIn = 0;
+	int		cbOut = 0;
+	int		bCode;
+	int		ib;
+
+	while ( ibIn < cbIn ) {
+		bCode = pbIn[ibIn++];
+		if ( ibIn + bCode - 1 > cbIn ) {
+			return -1;
+		}
+		for ( ib = 1; ib < bCode; ib++ ) {
+			pbOut[cbOut++] = pbIn[ibIn++];
+		}
+		if ( ( bCode != 0xFF ) && ( ibIn < cbIn ) ) {
+			pbOut[cbOut++] = 0;
+		}
+	}
+
+	return cbOut;
+}
+
+/* ------------------------------------------------------------ */
+/***	CrcFrame
+**
+**	Synopsis:
+**		crc = CrcFrame(pb, cb)
+**
+**	Parameters:
+**		pb - bytes
+**		cb - count
+**
+**	Return Values:
+**		CRC-16/CCITT-FALSE of the bytes, as CrcUart
+*/
+
+static uint16_t CrcFrame(const uint8_t * pb, int cb)
+{
+	uint16_t	crc = crcUartInit;
+	int			ibit;
+
+	while ( cb-- > 0 ) {
+		crc ^= (uint16_t)( *pb++ << 8 );
+		for ( ibit = 0; ibit < 8; ibit++ ) {
+			crc = ( crc & 0x8000 ) ? (uint16_t)( ( crc << 1 ) ^ crcUartPoly ) : (uint16_t)( crc << 1 );
+		}
+	}
+
+	return crc;
+}
+
+/* ------------------------------------------------------------ */
+/***	DecFrame
+**
+**	Synopsis:
+**		DecFrame(pdec, pb, cb)
+**
+**	Parameters:
+**		pdec - decoder state
+**		pb   - decoded frame, CRC last
+**		cb   - its length
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		counts and reports a bad CRC, counts a bad frame
+**
+**	Description:
+**		Checks the CRC and passes the frame on by its type.
+*/
+
+static void DecFrame(struct dec * pdec, const uint8_t * pb, int cb)
+{
+	uint16_t	crc;
+
+	if ( cb < 3 ) {
+		pdec->cBadFrame++;
+		return;
+	}
+
+	cb -= 2;
+	crc = (uint16_t)( pb[cb] | ( pb[cb + 1] << 8 ) );
+	if ( crc != CrcFrame(pb, cb) ) {
+		pdec->cCrcErr++;
+		fprintf(stderr, "telemdec: CRC error, %d byte frame\n", cb);
+		return;
+	}
+
+	pdec->cFrame++;
+	switch ( pb[0] ) {
+		case ftypTelemChan:
+			DecChan(pdec, pb, cb);
+			break;
+
+		case ftypTelemRec:
+			DecRec(pdec, pb, cb);
+			break;
+
+		case ftypTelemCap:
+			DecCap(pdec, pb, cb);
+			break;
+
+		default:
+			pdec->cBadFrame++;
+			break;
+	}
+}
+
+/* ------------------------------------------------------------ */
+/***	DecChan
+**
+**	Synopsis:
+**		DecChan(pdec, pb, cb)
+**
+**	Parameters:
+**		pdec - decoder state
+**		pb   - channel frame, without the CRC
+**		cb   - its length
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		counts a bad frame
+**
+**	Description:
+**		Takes the channel shifts, and writes the CSV header when the
+**		channel count changes.
+*/
+
+static void DecChan(struct dec * pdec, const uint8_t * pb, int cb)
+{
+	int		cch = pb[1];
+	int		ich;
+
+	if ( ( cb < 2 ) || ( cch == 0 ) || ( cch > cchTelemMax ) || ( cb != 2 + cch ) ) {
+		pdec->cBadFrame++;
+		return;
+	}
+
+	if ( !pdec->fChan || ( cch != pdec->cch ) ) {
+		printf("seq,tus");
+		for ( ich = 0; ich < cch; ich++ ) {
+			printf(",ch%d", ich);
+		}
+		printf("\n");
+	}
+
+	pdec->fChan	= 1;
+	pdec->cch	= cch;
+	for ( ich = 0; ich < cch; ich++ ) {
+		pdec->rgbnShift[ich] = pb[2 + ich];
+	}
+}
+
+/* ------------------------------------------------------------ */
+/***	DecRec
+**
+**	Synopsis:
+**		DecRec(pdec, pb, cb)
+**
+**	Parameters:
+**		pdec - decoder state
+**		pb   - record frame, without the CRC
+**		cb   - its length
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		counts a bad frame; reports records missing from the
+**		sequence
+**
+**	Description:
+**		Writes one CSV line.
+*/
+
+static void DecRec(struct dec * pdec, const uint8_t * pb, int cb)
+{
+	unsigned	seq;
+	unsigned	cLost;
+	uint32_t	tus;
+	int			cch = pb[1];
+	int			ich;
+
+	if ( ( cb < cbTelemRecHdr ) || ( cch > cchTelemMax ) || ( cb != cbTelemRecHdr + 2 * cch ) ) {
+		pdec->cBadFrame++;
+		return;
+	}
+
+	seq = pb[2] | ( pb[3] << 8 );
+	tus = (uint32_t)pb[4] | ( (uint32_t)pb[5] << 8 ) |
+		  ( (uint32_t)pb[6] << 16 ) | ( (uint32_t)pb[7] << 24 );
+
+	if ( pdec->fSeq ) {
+		cLost = ( seq - pdec->seqLast - 1 ) & 0xFFFF;
+		if ( cLost != 0 ) {
+			pdec->cRecLost += cLost;
+			fprintf(stderr, "telemdec: %u records lost before %u\n", cLost, seq);
+		}
+	}
+	pdec->fSeq		= 1;
+	pdec->seqLast	= seq;
+
+	if ( !pdec->fRaw && ( !pdec->fChan || ( cch != pdec->cch ) ) ) {
+		pdec->cRecSkip++;
+		return;
+	}
+	pdec->cRec++;
+
+	printf("%u,%lu", seq, (unsigned long)tus);
+	for ( ich = 0; ich < cch; ich++ ) {
+		PrintSample(stdout, pdec, ich, &pb[cbTelemRecHdr + 2 * ich]);
+	}
+	printf("\n");
+}
+
+/* ------------------------------------------------------------ */
+/***	DecCap
+**
+**	Synopsis:
+**		DecCap(pdec, pb, cb)
+**
+**	Parameters:
+**		pdec - decoder state
+**		pb   - capture frame, without the CRC
+**		cb   - its length
+**
+**	Return Values:
+**		none
+**
+**	Errors:
+**		counts a bad frame; reports a capture that cannot be written
+**		or has records missing, and writes the rest of it anyway
+**
+**	Description:
+**		Writes one record of a capture. Record 0 starts the file.
+*/
+
+static void DecCap(struct dec * pdec, const uint8_t * pb, int cb)
+{
+	char		szFile[1024];
+	unsigned	fbTrig;
+	unsigned	icap;
+	unsigned	irec;
+	unsigned	crec;
+	unsigned	irecTrig;
+	int			cch = pb[1];
+	int			ich;
+
+	if ( ( cb < cbTelemCapHdr ) || ( cch > cchTelemMax ) || ( cb != cbTelemCapHdr + 2 * cch ) ) {
+		pdec->cBadFrame++;
+		return;
+	}
+
+	fbTrig		= pb[2];
+	icap		= pb[3];
+	irec		= pb[4] | ( pb[5] << 8 );
+	crec		= pb[6] | ( pb[7] << 8 );
+	irecTrig	= pb[8] | ( pb[9] << 8 );
+
+	if ( irec == 0 ) {
+		if ( pdec->pfileCap != NULL ) {
+			fprintf(stderr, "telemdec: capture %u cut short\n", pdec->icap);
+			fclose(pdec->pfileCap);
+			pdec->pfileCap = NULL;
+		}
+		pdec->cCap++;
+		pdec->icap			= icap;
+		pdec->irecCapNext	= 0;
+		fprintf(stderr, "telemdec: capture %u, trigger 0x%02X, %u records, %u before it\n",
+				icap, fbTrig, crec, irecTrig);
+
+		if ( pdec->szCapPrefix != NULL ) {
+			snprintf(szFile, sizeof(szFile), "%s-%03u.csv", pdec->szCapPrefix, icap);
+			pdec->pfileCap = fopen(szFile, "w");
+			if ( pdec->pfileCap == NULL ) {
+				fprintf(stderr, "telemdec: %s: %s\n", szFile, strerror(errno));
+				return;
+			}
+			fprintf(pdec->pfileCap, "n");
+			for ( ich = 0; ich < cch; ich++ ) {
+				fprintf(pdec->pfileCap, ",ch%d", ich);
+			}
+			fprintf(pdec->pfileCap, "\n");
+		}
+	}
+
+	if ( ( pdec->pfileCap == NULL ) || ( icap != pdec->icap ) ) {
+		return;
+	}
+	if ( irec != pdec->irecCapNext ) {
+		fprintf(stderr, "telemdec: capture %u: %u records lost before %u\n",
+				icap, irec - pdec->irecCapNext, irec);
+	}
+	pdec->irecCapNext = irec + 1;
+
+	fprintf(pdec->pfileCap, "%d", (int)irec - (int)irecTrig);
+	for ( ich = 0; ich < cch; ich++ ) {
+		PrintSample(pdec->pfileCap, pdec, ich, &pb[cbTelemCapHdr + 2 * ich]);
+	}
+	fprintf(pdec->pfileCap, "\n");
+
+	if ( irec + 1 >= crec ) {
+		fclose(pdec->pfileCap);
+		pdec->pfileCap = NULL;
+	}
+}
+
+/* ------------------------------------------------------------ */
+/***	PrintSample
+**
+**	Synopsis:
+**		PrintSample(pfile, pdec, ich, pb)
+**
+**	Parameters:
+**		pfile - output
+**		pdec  - decoder state
+**		ich   - channel
+**		pb    - the sample, little endian
+**
+**	Return Values:
+**		none
+**
+**	Description:
+**		Writes a comma and the sample, raw or scaled by the shift of
+**		its channel. A channel the channel frame did not cover is
+**		written raw.
+*/
+
+static void PrintSample(FILE * pfile, struct dec * pdec, int ich, const uint8_t * pb)
+{
+	int16_t		s = (int16_t)( pb[0] | ( pb[1] << 8 ) );
+
+	if ( pdec->fRaw || !pdec->fChan || ( ich >= pdec->cch ) ) {
+		fprintf(pfile, ",%d", s);
+	}
+	else {
+		fprintf(pfile, ",%.6g", (double)s * (double)( 1UL << pdec->rgbnShift[ich] ) / 65536.0);
+	}
+}
+
+/************************************************************************/
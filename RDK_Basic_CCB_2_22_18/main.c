@@ -28,6 +28,37 @@
 /*   02/05/18: Implemented wheel timing and cleaned up the code         */
 /*   02/06/18: Heavily cleaned up and commented code                    */
 /*   02/14/18: Implemented Speed Control for Right wheel                */
+/*   10/16/26: Capture ISRs compute wheel speed in Q16 fixed point      */
+/*   10/16/26: Capture ISRs queue timestamps; speed runs in Timer 5     */
+/*   10/16/26: Timer 3 overflow handling moved to Timebase.c            */
+/*   10/16/26: Wheel speed measured with the M/T method                 */
+/*   10/16/26: IC ISRs generated per channel in Encoder.c               */
+/*   10/16/26: Encoder ticks and speeds are signed (SA/SB quadrature)   */
+/*   10/16/26: Capture prescale adapts to wheel speed                   */
+/*   10/16/26: Motor PWM moved to Pwm.c; OPT_TB32 32-bit capture        */
+/*   10/16/26: Fixed point odometry (Odom.c) updated in Timer 5         */
+/*   10/16/26: Wheel PIDs use the fixed point controller in Pid.c       */
+/*   10/16/26: Control tick moved to Timer 4 at IPL4 (Control.c);       */
+/*   Timer 5 debounce lowered to IPL2                                   */
+/*   10/16/26: Control rate set by frqCtrlTick; tick timing statistics  */
+/*   10/16/26: Speed to duty feedforward tables; BTN1 runs the sweep    */
+/*   10/16/26: Relay feedback PID autotune (Tune.c) on PmodSWT1         */
+/*   10/16/26: Cross-coupled wheel synchronization (OPT_WHEELSYNC)      */
+/*   10/16/26: Wheel PID gains scheduled on the commanded speed         */
+/*   10/16/26: S-curve setpoint profiles (Profile.c) per wheel          */
+/*   10/16/26: Encoder closed loop drive/turn moves (Move.c); maneuvers */
+/*   on PmodBTN1-4 and PmodSWT2-3                                       */
+/*   10/16/26: Wheel speed from a Kalman observer run at the control    */
+/*   rate on the capture timestamps, replacing the per-edge average     */
+/*   10/16/26: Static friction compensation (Fric.c) replaces the PID   */
+/*   duty floor and the jump start experiment                           */
+/*   10/16/26: Signed wheel PID outputs; Pwm.c owns the direction pins  */
+/*   and reverses a motor only after a PWM period with its enable low   */
+/*   10/16/26: 16-bit telemetry recorder (Telem.c) replaces hist0..5    */
+/*   10/16/26: Telemetry streamed as COBS frames on UART2 (Uart.c) with */
+/*   a host decoder in host/telemdec.c (OPT_TELEMUART)                  */
+/*   10/16/26: Triggered scope capture of the loop telemetry on a       */
+/*   setpoint change, speed error or BTN2 (OPT_TELEMSCOPE)              */
 /************************************************************************/
 
 /* ------------------------------------------------------------ */
@@ -40,6 +71,18 @@
 #include "MtrCtrl.h"
 #include "spi.h"
 #include "util.h"
+#include "fixmath.h"
+#include "Encoder.h"
+#include "Timebase.h"
+#include "Pwm.h"
+#include "Odom.h"
+#include "Pid.h"
+#include "Control.h"
+#include "Ffwd.h"
+#include "Tune.h"
+#include "Move.h"
+#include "Uart.h"
+#include "Telem.h"
 
 /* ------------------------------------------------------------ */
 /*				Local Type Definitions							*/
@@ -55,22 +98,12 @@
 #define 	TCKPS30				4
 
 #define     revCounter          1575 // counting IC2/IC3 for 10ish revolutions
-#define     initSpeedLeft       0 // Initialized speed for left wheel
-#define     initSpeedRight      0 // Initialized speed for right wheel
-#define     timer2MaxVal        9999 // Timer2 overflows at this value
-#define     timer3MaxVal        49999 // Timer3 overflows at this value (50ms)
 
-#define     wheelC              0.71886 // Circumference of the wheel in feet
+#define	ftManeuver		Q16FromFloat(2.0)	// leg length of the maneuvers
+#define	spdManeuver		Q16FromFloat(0.75)	// cruise speed of the maneuvers
 
-#define     bufferNotEmpty      3 // Bit in ICxCON register for buffer not empty
 
-#define     IC2IntFlag          9 // Bit in IFS0 register for IC2's interrupt flag
-#define     IC3IntFlag          13 // Bit in IFS0 register for IC3's interrupt flag
-#define     T3IntFlag           12 // Bit in IFS0 register for T3's interrupt flag
 
-#define     IC2IntEnable        9 // Bit in IEC0 register for IC2's enable
-#define     IC3IntEnable        13 // Bit in IEC0 register for IC3's enable
-#define     T3IntEnable         12 // Bit in IEC0 register for T3's enable
 
 //#define     alpha               0.1 // percent of new data point used in PID
 //#define     beta                1-alpha
@@ -148,45 +181,14 @@ volatile	struct btn	PmodSwt2;
 volatile	struct btn	PmodSwt3;
 volatile	struct btn	PmodSwt4;
 
-unsigned int IC2Counter = 0;
-unsigned int IC3Counter = 0;
-
-//unsigned int IC2OVCounter = 0;
-unsigned int IC3OVCounter = 0;
-
-float IC2Time = 0.0;
-float IC3Time = 0.0;
-
 unsigned int desired_time = 3500; // microseconds
-float desired_spd = 0.75; // ft/s
-float integral_error = 0.0;
-float err = 0.0;
-
-float hist0[500];
-float hist1[500];
-float hist2[500];
-float hist3[500];
-float hist4[500];
-float hist5[500];
-
 
 int full_error = 3500;
 
 unsigned int desired_time2 = 3500; // microseconds
-float desired_spd2 = 0.6; // ft/s
-float integral_error2 = 0.0;
-float err2 = 0.0;
 
 int full_error2 = 3500;
 
-float Kp2 = 2500.0;
-float Ki2;
-float Kd2;
-
-float Kp = 2500.0;
-float Ki;
-float Kd;
-
 //float alpha = 0.1; // percent of new data point used in PID
 //float beta = 0.9; //1-alpha;
 
@@ -195,26 +197,6 @@ float distanceR = 0; // value for distance traveled by right wheel (IC3)
 float speedL = 0; // speed of left wheel in fps
 float speedR = 0; // speed of right wheel in fps
 
-// Used for speed control in Timer5 ISR
-
-float IC2_speed = 0.0;
-float IC2_spd_avg = 0.0;
-
-float IC3_speed = 0.0;
-float IC3_spd_avg = 0.0;
-/* written to in T3 ISR
- * read in IC2&IC3 ISRs
- * used for counting number of overflows of T3
- * 50ms per overflow
- */
-unsigned int T3_OV_Count = 0;
-
-int delta_time2 = 0;
-int delta_time3 = 0;
-
-// These take on the value of local variables so that they can be watched
-int time2;
-int time3;
 
 /* ------------------------------------------------------------ */
 /*				Forward Declarations							*/
@@ -223,6 +205,9 @@ int time3;
 void	DeviceInit(void);
 void	AppInit(void);
 void	Wait_ms(WORD ms);
+BOOL	FMoveWait(void);
+BOOL	FManeuverSquare(void);
+BOOL	FManeuverTriangle(void);
 
 /* ------------------------------------------------------------ */
 /*				Interrupt Service Routines						*/
@@ -243,212 +228,15 @@ void	Wait_ms(WORD ms);
 **		is used to perform software debouncing of the on-board
 **		buttons. It is also used as a time base for updating
 **		the on-board LEDs and the Pmod8LD LEDs at a regular interval.
+**		The wheel speed control runs in Timer4Handler (Control.c).
 */
 
 
-// IC2 and IC3 are connected to the wheels
-// ipl = interrupt priority level
-void __ISR(_INPUT_CAPTURE_2_VECTOR, ipl6) _IC2_IntHandler(void)
-{
-    static int time = 0;
-    static int prev_time = 0;
-    int T3_OV_Count_Local;
-    static int prev_T3_OV_Count_Local = 0;
-    static float alpha = 0.1;
-    static float beta = 0.9;
-    
-    T3_OV_Count_Local = T3_OV_Count; //make a copy of the global variable to fix its value for this ISR
-    
-	IFS0CLR	= ( 1 << IC2IntFlag ); // clear interrupt flag for Input Capture 2
-    
-    //Reading the buffer whenever it is not empty
-    
-    while((IC2CON & ( 1 << bufferNotEmpty )) == ( 1 << bufferNotEmpty ))
-    {
-        time = (int) (IC2BUF & 0x0000FFFF); // mask off the upper half of the buffer
-        
-        delta_time2 = time - prev_time; //keep track of delta time
-        
-        /* It is possible that an overflow occurred but the counter did not
-         * increase; this statement catches such an occurrence
-         */ 
-        if ((delta_time2 <= 0)&&(T3_OV_Count_Local == prev_T3_OV_Count_Local))
-        {
-            delta_time2 += 50000;
-            //IC2OVCounter++;
-            T3_OV_Count_Local++;
-        }
-    }
-    
-	IC2Counter++;
-    
-   
-    IC2Time = T3_OV_Count_Local*50000 + time; //new(er) time algorithm microseconds
-    //IC2_speed = 5000.0/(float)delta_time2;
-    if(delta_time2 > 500)
-       IC2_speed = 5000.0/(float)delta_time2;
-    else
-       IC2_speed = 2.0;
-    IC2_spd_avg = alpha*IC2_speed + beta*IC2_spd_avg;
-    
-    // Update state variables
-    prev_time = time;
-    time2 = time;
-    prev_T3_OV_Count_Local = T3_OV_Count_Local;
-}
-
-void __ISR(_INPUT_CAPTURE_3_VECTOR, ipl6) _IC3_IntHandler(void)
-{
-    static int time = 0;
-    static int prev_time = 0;
-    int T3_OV_Count_Local;
-    static int prev_T3_OV_Count_Local = 0;
-    static float alpha = 0.1;
-    static float beta = 0.9;
-    
-    T3_OV_Count_Local = T3_OV_Count; //make a copy of the global variable to fix its value for this ISR
-    
-	IFS0CLR	= ( 1 << IC3IntFlag );	// clear interrupt flag for Input Capture 3	
-    
-    //Reading the buffer whenever it is not empty
-    
-    while((IC3CON & ( 1 << bufferNotEmpty )) == ( 1 << bufferNotEmpty ))
-    {
-        time = (int) (IC3BUF & 0x0000FFFF); // mask off the upper half of the buffer
-        
-        /* It is possible that an overflow occurred but the counter did not
-         * increase; this statement catches such an occurrence
-         */ 
-        delta_time3 = time - prev_time; //keep track of delta time
-        if ((delta_time3 <= 0)&&(T3_OV_Count_Local == prev_T3_OV_Count_Local))
-        {
-            delta_time3 += 50000;
-            IC3OVCounter++;
-            T3_OV_Count_Local++;
-        }
-    }
-     
-    // For testing if we want to fill data vector once and hold execution in this ISR
-     /*if (count>=499) 
-      while(1)
-      {
-          count = count;
-      }*/
-    
-	IC3Counter++;
-    
-
-    IC3Time = T3_OV_Count_Local*50000 + time; //new(er) time algorithm microseconds
-    //IC3_speed = 5000.0/(float)delta_time3;
-    if(delta_time3 > 500)
-       IC3_speed = 5000.0/(float)delta_time3;
-    else
-       IC3_speed = 2.0;
-    IC3_spd_avg = alpha*IC3_speed + beta*IC3_spd_avg;
-    
-    // Update state variables
-    prev_time = time;
-    time3 = time;
-    prev_T3_OV_Count_Local = T3_OV_Count_Local;
-}
-
-void __ISR(_TIMER_3_VECTOR, ipl5) Timer3Handler(void)
-{
-    
-    IFS0CLR = ( 1 << T3IntFlag ); //clear T3 interrupt flag
-    T3_OV_Count++;
-}
-
-void __ISR(_TIMER_5_VECTOR, ipl7) Timer5Handler(void)
+void __ISR(_TIMER_5_VECTOR, ipl2) Timer5Handler(void)
 {
 	static	WORD tusLeds = 0;
-	static int T5_count = 0;
-	
-    
-    float temp_output;
-    //float err = 0;
-    static float prev_error = 0.0;
-    
-    float temp_output2;
-    //float err2 = 0;
-    static float prev_error2 = 0.0;
-    static int index = 0;
     
     mT5ClearIntFlag();
-    //full_error = desired_time; // full_error is equal to desired_time
-    //Kp = 5000/full_error; // Kp*full_error = 50% of output range, output range = 10000 ms
-    
-    Ki2 = Kp2/10.0;
-    Kd2 = Kp2/100.0;
-    
-    
-    Ki = Kp/10.0;
-    Kd = Kp/100.0;
-    
-/* ------------------------------------------------------------ */
-/*				Right Wheel PID     							*/
-/* ------------------------------------------------------------ */
-    
-    //error = desired_time - avg_meas_time; 
-    err = desired_spd - IC3_spd_avg; 
-    integral_error += err;
-    
-    if(integral_error > 25000/Ki) integral_error = 25000/Ki; // Bounds integral_error
-    else if(integral_error < -25000/Ki) integral_error = -25000/Ki;
-    
-    //temp_output = 10000 - (Kp*err + Ki*integral_error + Kd*(err-prev_error)); //subtract from 10000 for time control
-    temp_output = Kp*err + Ki*integral_error + Kd*(err-prev_error); //subtract from 10000 for time control
-    
-    hist0 [index] = IC3_spd_avg;
-    hist1[index] = Kp*err;
-    hist2[index] = Ki*integral_error;
-    hist3[index] = Kd*(err-prev_error);
-    hist4[index] = temp_output;
-    
-    if(temp_output > 9999) temp_output = 9999; // Bounds temp_output between 0 and 10000
-    else if(temp_output < 800) temp_output = 800; // Prevent startup issue
-    
-/* ------------------------------------------------------------ */
-/*				Left Wheel PID        							*/
-/* ------------------------------------------------------------ */
-    
-     //error = desired_time - avg_meas_time; 
-    err2 = desired_spd2 - IC2_spd_avg; 
-    integral_error2 += err2;
-    
-    if(integral_error2 > 25000/Ki2) integral_error2 = 25000/Ki2; // Bounds integral_error
-    else if(integral_error2 < -25000/Ki2) integral_error2 = -25000/Ki2;
-    
-    //temp_output = 10000 - (Kp*err + Ki*integral_error + Kd*(err-prev_error)); //subtract from 10000 for time control
-    temp_output2 = Kp2*err2 + Ki2*integral_error2 + Kd2*(err2-prev_error2);
-    
-    hist5[index] = IC2_spd_avg;
-    
-    if(temp_output2 > 9999) temp_output2 = 9999; // Bounds temp_output between 0 and 10000
-    else if(temp_output2 < 800) temp_output2 = 800; // Prevent startup issue
-    
-    
-    // Startup testing to see if motors can be jump started and stay moving
-    // Worked until T5_count reached its limit then stopped again
-    /*if(T5_count < 500) temp_output += 2000.0;
-    else 
-    { temp_output = temp_output;}
-    T5_count++;  // cheeky American*/
-    
-    
-    OC2R = (HWORD)temp_output2;
-    OC2RS = (HWORD)temp_output2;
-    OC3R = (HWORD)temp_output;
-    OC3RS = (HWORD)temp_output;
-    
-    // Update state variables
-    prev_error2 = err2;
-    prev_error = err;
-    
-    
-    // Index increment and reset, while(1) used for startup testing, NEEDS TO BE REMOVED BEFORE RELEASE 
-    index++;
-    if(index > 499)  { index = 0; } //index = 0;
     
 	// Read the raw state of the button pins.
 	btnBtn1.stCur = ( prtBtn1 & ( 1 << bnBtn1 ) ) ? stPressed : stReleased;
@@ -564,10 +352,12 @@ void __ISR(_TIMER_5_VECTOR, ipl7) Timer5Handler(void)
 
 }
 
+#if !OPT_TB32
 void __ISR (_OUTPUT_COMPARE_2_VECTOR, ipl6) OC2_IntHandler (void)
 {
     IFS0CLR = (1 << 10); // Clears OC2 interrupt status flag
 }
+#endif
 /* ------------------------------------------------------------ */
 /*				Procedure Definitions							*/
 /* ------------------------------------------------------------ */
@@ -594,14 +384,20 @@ int main(void) {
     
     
 	BYTE	stBtn1;
+	BYTE	stBtn1Prev = stReleased;
 	BYTE	stBtn2;
+	BYTE	stBtn2Prev = stReleased;
 
 	BYTE	stPmodBtn1;
 	BYTE	stPmodBtn2;
 	BYTE	stPmodBtn3;
 	BYTE	stPmodBtn4;
+	BYTE	stPmodBtnPrev = stReleased;		// any PmodBTN pressed
 
 	BYTE	stPmodSwt1;
+	BYTE	stPmodSwt1Prev = stReleased;
+	BYTE	stPmodSwt2Prev = stReleased;
+	BYTE	stPmodSwt3Prev = stReleased;
 	BYTE	stPmodSwt2;
 	BYTE	stPmodSwt3;
 	BYTE	stPmodSwt4;
@@ -619,7 +415,7 @@ int main(void) {
 
 	//write to PmodCLS
     //int n_2 = sprintf(bufftemp ,"IC2Count: %i", IC2Counter);
-    int n_2 = sprintf(bufftemp , "Lspeed: %.4f", IC2_spd_avg);
+    int n_2 = sprintf(bufftemp , "Lspeed: %.4f", FloatFromQ16(encLeft.spdEst));
     
 	SpiEnable();
 	SpiPutBuff(szClearScreen, 3);
@@ -631,7 +427,7 @@ int main(void) {
 	SpiPutBuff(bufftemp, n_2);
     //SpiPutBuff("IC2Count: %d", 9);
     //int n_3 = sprintf(bufftemp ,"IC3Count: %i", IC3Counter);
-	int n_3 = sprintf(bufftemp , "Rspeed: %.4f", IC3_spd_avg);
+	int n_3 = sprintf(bufftemp , "Rspeed: %.4f", FloatFromQ16(encRight.spdEst));
     DelayMs(4);
 	SpiPutBuff(szCursorPosRow1, 6);
 	DelayMs(4);
@@ -648,14 +444,14 @@ int main(void) {
         //write to PmodCLS
     
     //n_2 = sprintf(bufftemp ,"IC2Count: %i", IC2Counter);
-    int n_2 = sprintf(bufftemp , "Lspeed: %.4f", IC2_spd_avg);
+    int n_2 = sprintf(bufftemp , "Lspeed: %.4f", FloatFromQ16(encLeft.spdEst));
 	SpiEnable();
 	DelayMs(1);
     SpiPutBuff(szCursorPosHome, 6);
 	SpiPutBuff(bufftemp, n_2);
     //SpiPutBuff("IC2Count: %d", 9);
     //n_3 = sprintf(bufftemp ,"IC3Count: %i", IC3Counter);
-    int n_3 = sprintf(bufftemp , "Rspeed: %.4f", IC3_spd_avg);
+    int n_3 = sprintf(bufftemp , "Rspeed: %.4f", FloatFromQ16(encRight.spdEst));
 	DelayMs(1);
 	SpiPutBuff(szCursorPosRow1, 6);
 	SpiPutBuff(bufftemp, n_3);
@@ -679,6 +475,61 @@ int main(void) {
 		stPmodSwt4 = PmodSwt4.stBtn;
 
 		INTEnableInterrupts();
+
+		// BTN1 runs the feedforward characterization sweep; turning
+		// SWT1 on tunes both wheel PIDs. One at a time.
+		if ( ( stPressed == stBtn1 ) && ( stPressed != stBtn1Prev ) &&
+			 !FTuneRunning() ) {
+			FfwdSweepStart();
+		}
+		stBtn1Prev = stBtn1;
+
+		// BTN2 triggers the telemetry scope capture.
+		if ( ( stPressed == stBtn2 ) && ( stPressed != stBtn2Prev ) &&
+			 ( ( fbCtrlTrig & fbCtrlTrigBtn ) != 0 ) ) {
+			TelemTrigger(fbCtrlTrigBtn);
+		}
+		stBtn2Prev = stBtn2;
+
+		if ( ( stPressed == stPmodSwt1 ) && ( stPressed != stPmodSwt1Prev ) &&
+			 !FFfwdSweeping() ) {
+			TuneStart();
+		}
+		stPmodSwt1Prev = stPmodSwt1;
+
+		// PmodBTN1-4 drive 2 ft forward or back, or turn 90 degrees
+		// right or left; SWT2 drives a square to the right and SWT3 a
+		// triangle to the left. All of them stop on the encoders. A
+		// button pressed while a move runs is refused and ignored; a
+		// maneuver aborts any move first, and stops where it is if a
+		// leg fails.
+		if ( stPressed != stPmodBtnPrev ) {
+			if ( stPressed == stPmodBtn1 ) {
+				FMoveDrive(ftManeuver, spdManeuver);
+			}
+			else if ( stPressed == stPmodBtn2 ) {
+				FMoveDrive(-ftManeuver, spdManeuver);
+			}
+			else if ( stPressed == stPmodBtn3 ) {
+				FMoveTurn(-Q16FromInt(90), spdManeuver);
+			}
+			else if ( stPressed == stPmodBtn4 ) {
+				FMoveTurn(Q16FromInt(90), spdManeuver);
+			}
+		}
+		stPmodBtnPrev = ( ( stPressed == stPmodBtn1 ) || ( stPressed == stPmodBtn2 ) ||
+						  ( stPressed == stPmodBtn3 ) || ( stPressed == stPmodBtn4 ) ) ?
+						stPressed : stReleased;
+
+		if ( ( stPressed == stPmodSwt2 ) && ( stPressed != stPmodSwt2Prev ) ) {
+			FManeuverSquare();
+		}
+		stPmodSwt2Prev = stPmodSwt2;
+
+		if ( ( stPressed == stPmodSwt3 ) && ( stPressed != stPmodSwt3Prev ) ) {
+			FManeuverTriangle();
+		}
+		stPmodSwt3Prev = stPmodSwt3;
         
         //Run wheels for revCounter pulses then stop
         /*if (IC2Counter >= revCounter)
@@ -693,11 +544,11 @@ int main(void) {
             OC3RS = dtcMtrStopped;
         }*/
         
-        distanceL = (IC2Counter/160)*wheelC;
-        distanceR = (IC3Counter/160)*wheelC;
+        distanceL = FloatFromQ16(OdomFtQ16(encLeft.cTick));
+        distanceR = FloatFromQ16(OdomFtQ16(encRight.cTick));
         
-        speedL = (distanceL/((float) IC2Time))*1000000;
-        speedR = (distanceR/((float) IC3Time))*1000000;
+        speedL = (distanceL/((float) encLeft.tusPrev))*1000000;
+        speedR = (distanceR/((float) encRight.tusPrev))*1000000;
        
 		//configure OCR to go forward
 
@@ -932,83 +783,54 @@ int main(void) {
 
 void DeviceInit() {
 
-    //Set IC2 and IC3 as inputs (they are on PORTD Pins 9/10 respectively)
-    TRISDSET = (1 << 9) | (1 << 10);
+    //IC2 and IC3 (PORTD Pins 9/10) are set as inputs in EncInit
     //TRISBSET = (1 << 2) | (1 << 3) | (1 <<4);
     
-	// Configure left motor direction pin and set default direction.
-	trisMtrLeftDirClr	= ( 1 << bnMtrLeftDir );    // setting up Port D (the way we connected the hardware defines this))
-	prtMtrLeftDirClr	= ( 1 << bnMtrLeftDir );	// forward (left needs to be a 0)
-	
-	// Configure right motor direction pin and set default direction.
-	trisMtrRightDirClr	= ( 1 << bnMtrRightDir );	
-	prtMtrRightDirSet	= ( 1 << bnMtrRightDir );	// forward (right needs to be a 1)
-    
-	// Configure Output Compare 2 to drive the left motor.
-	OC2CON	= ( 1 << 2 ) | ( 1 << 1 );	// pwm using T2
-	OC2R	= initSpeedLeft;
-	OC2RS	= initSpeedLeft;
-
-	// Configure Output Compare 3 to drive the right motor.
-	OC3CON  = ( 1 << 2 ) | ( 1 << 1 );	// pwm using T2
-	OC3R	= initSpeedRight;
-	OC3RS	= initSpeedRight;
+	// Configure Timer 3 (Timer 2/3 with OPT_TB32) used for real timing
+	// (also the IC timebase)
+	TbInit();
 
-	// Configure Timer 2 used for PWM
-	TMR2	= 0; // clear T2 count
-	PR2		= timer2MaxVal;
-
-	// Configure Timer 3 used for real timing
-	TMR3	= 0; // clear T3 count
-	PR3		= timer3MaxVal;
-
-	// Start timers and output compare units.
-    
-    // Bit 15 is the enable; setting TCKPS = [011] results in prescaler of 8
-	T2CON		= ( 1 << 15 ) | ( 1 << TCKPS20 ) | ( 1 << TCKPS21 );	// timer 2 prescale = 8
-    T3CON		= ( 1 << 15 ) | ( 1 << TCKPS31 ) | ( 1 << TCKPS30 ); 	// timer 3 prescale = 8
-	OC2CONSET	= ( 1 << 15 );	// enable output compare module 2
-	OC3CONSET	= ( 1 << 15 );	// enable output compare module 3
-    
-    // Set IC3 and IC2 to rising edge only capture mode
-    IC3CONSET = ( 1 << 1 ) | ( 1 << 0 );
-    IC2CONSET = ( 1 << 1 ) | ( 1 << 0 );
+	// Configure OC2 (left motor) and OC3 (right motor), both stopped,
+	// and the motor direction pins, both forward
+	PwmInit();
 
 	// Configure Timer 5.
 	TMR5	= 0;
-	PR5		= 22999; // period match every 23 ms
+	PR5		= 22999; // period match every 23 ms (debounce)
     
 /* ------------------------------------------------------------ */
 /*				Interrupt Priorities							*/
 /* ------------------------------------------------------------ */
     
-    // Level 7, sub 3
-	IPC5SET	= ( 1 << 4 ) | ( 1 << 3 ) | ( 1 << 2 ) | ( 1 << 1 ) | ( 1 << 0 ); // Timer 5
-    
-    // Level 6, sub 3
-    IPC3SET	= ( 1 << 12 ) | ( 1 << 11 ) | ( 1 <<  9 ) | ( 1 <<  8 ); // IC3
-    IPC2SET	= ( 1 << 12 ) | ( 1 << 11 ) | ( 1 <<  9 );// | ( 1 <<  8 ); // IC2
+    // Level 6, sub 3 (IC2 and IC3 are set in EncInit, OC2 and OC3 in
+    // PwmInit with OPT_TB32)
+#if !OPT_TB32
     IPC2SET = ( 1 << 20 ) | ( 1 << 19 ) | ( 1 << 17 ) | ( 1 << 16 ); // OC2
+#endif
     
-    // Level 5, sub 3
-    IPC3SET = ( 1 << 4 ) | ( 1 << 2 ) | ( 1 << 1 ) | ( 1 << 0 ); // Timer 3
+    // Level 5, sub 3: Timer 3, set in TbInit
     //IPC6SET = ( 1 << 28) | (1 << 26) | (1 << 25) | (1 << 24); // ADC
     
+    // Level 4, sub 3: Timer 4 (control tick), set in CtrlInit
+    
+    // Level 2, sub 3
+	IPC5SET	= ( 1 << 3 ) | ( 1 << 1 ) | ( 1 << 0 ); // Timer 5
+
+    // Level 1, sub 3: UART2 (telemetry stream), set in UartInit
+    
     
     // Clearing status flags
 	IFS0CLR = ( 1 << 20 ); // Timer 5
-    IFS0CLR = ( 1 << IC3IntFlag ); // IC3
-    IFS0CLR = ( 1 << IC2IntFlag ); // IC2
+#if !OPT_TB32
     IFS0CLR = ( 1 << 10 ); // OC2
-    IFS0CLR = ( 1 << T3IntFlag ); // T3
+#endif
     //IFS1CLR = ( 1 << 1); // ADC
     
     // Enabling interrupts
     IEC0SET	= ( 1 << 20 ); // Timer 5
-    IEC0SET	= ( 1 << IC3IntEnable ); // IC3
-    IEC0SET	= ( 1 << IC2IntEnable ); // IC2
+#if !OPT_TB32
     IEC0SET = ( 1 << 10 ); // OC2
-    IEC0SET = ( 1 << T3IntEnable ); // Timer 3
+#endif
     //IEC1SET = ( 1 << 1 ); // ADC
 	
 	// Start timers.
@@ -1018,9 +840,17 @@ void DeviceInit() {
 	//enable SPI
 	SpiInit();
 
-    // Turn on IC3 and IC2 ISRs
-    IC3CONSET = (1 << 15);
-    IC2CONSET = (1 << 15);
+    // Configure and turn on IC2 and IC3 (wheel encoders)
+    EncInit();
+    OdomReset(0, 0);
+
+#if OPT_TELEMUART
+    // Configure UART2 for the telemetry stream
+    UartInit();
+#endif
+
+    // Configure the wheel PIDs and start the Timer 4 control tick
+    CtrlInit();
     
 	// Enable multi-vector interrupts.
 	INTEnableSystemMultiVectoredInt();
@@ -1054,6 +884,11 @@ void DeviceInit() {
 
 void AppInit() {
 
+#if OPT_ENCBENCH
+	INTDisableInterrupts();
+	EncBenchRun();
+	INTEnableInterrupts();
+#endif
 
 
 }
@@ -1103,4 +938,108 @@ void Wait_ms(WORD delay) {
 	}
 }
 
+/* ------------------------------------------------------------ */
+/***	FMoveWait
+**
+**	Synopsis:
+**		f = FMoveWait()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		fTrue if the move arrived
+**
+**	Errors:
+**		fails if the move ran out of its tick budget
+**
+**	Description:
+**		Waits for the move in progress to finish.
+*/
+
+BOOL FMoveWait(void) {
+
+	while ( FMoveBusy() ) {
+		;
+	}
+
+	return !FMoveFailed();
+}
+
+/* ------------------------------------------------------------ */
+/***	FManeuverSquare
+**
+**	Synopsis:
+**		f = FManeuverSquare()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		fTrue if every leg arrived
+**
+**	Errors:
+**		stops the robot where it is if a leg could not be started or
+**		ran out of its tick budget
+**
+**	Description:
+**		Drives a square of ftManeuver sides, turning right, and ends
+**		where and as it started. A move already running, such as one
+**		from a PmodBTN button, is aborted first.
+*/
+
+BOOL FManeuverSquare(void) {
+
+	BYTE	iside;
+
+	MoveAbort();
+	for ( iside = 0; iside < 4; iside++ ) {
+		if ( !FMoveDrive(ftManeuver, spdManeuver) || !FMoveWait() ||
+			 !FMoveTurn(-Q16FromInt(90), spdManeuver) || !FMoveWait() ) {
+			MoveAbort();
+			return fFalse;
+		}
+	}
+
+	return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***	FManeuverTriangle
+**
+**	Synopsis:
+**		f = FManeuverTriangle()
+**
+**	Parameters:
+**		none
+**
+**	Return Values:
+**		fTrue if every leg arrived
+**
+**	Errors:
+**		stops the robot where it is if a leg could not be started or
+**		ran out of its tick budget
+**
+**	Description:
+**		Drives an equilateral triangle of ftManeuver sides, turning
+**		left, and ends where and as it started. A move already
+**		running is aborted first.
+*/
+
+BOOL FManeuverTriangle(void) {
+
+	BYTE	iside;
+
+	MoveAbort();
+	for ( iside = 0; iside < 3; iside++ ) {
+		if ( !FMoveDrive(ftManeuver, spdManeuver) || !FMoveWait() ||
+			 !FMoveTurn(Q16FromInt(120), spdManeuver) || !FMoveWait() ) {
+			MoveAbort();
+			return fFalse;
+		}
+	}
+
+	return fTrue;
+}
+
 /************************************************************************/